@@ -351,6 +351,11 @@ AC_ARG_ENABLE(dot2gml_translator,
 ])
 AM_CONDITIONAL(DOT_TO_GML_TRANSLATOR,test "$enable_dot2gml_translator" = yes)
 
+# The system dependence graph in src/midend/programAnalysis/systemDependenceGraph does not compile with every
+# compiler that ROSE supports, so it (and its tests) are built only when asked for.
+AC_ARG_ENABLE(system-dependence-graph, AS_HELP_STRING([--enable-system-dependence-graph], [Build and test the system dependence graph library in src/midend/programAnalysis/systemDependenceGraph]), enable_system_dependence_graph="$enableval", enable_system_dependence_graph=no)
+AM_CONDITIONAL(ROSE_WITH_SYSTEM_DEPENDENCE_GRAPH, test "x$enable_system_dependence_graph" = "xyes")
+
 # Set the value of srcdir so that it will be an absolute path instead of a relative path
 # srcdir=`dirname "$0"`
 # echo "In ROSE/con figure: srcdir = $srcdir"
@@ -2214,6 +2219,7 @@ tests/CompilerOptionsTests/tokenStream_tests/Makefile
 tests/roseTests/Makefile
 tests/roseTests/abstractMemoryObjectTests/Makefile
 tests/roseTests/PHPTests/Makefile
+tests/roseTests/astDiagnostics/Makefile
 tests/roseTests/astFileIOTests/Makefile
 tests/roseTests/astInliningTests/Makefile
 tests/roseTests/astInterfaceTests/Makefile
@@ -2238,6 +2244,7 @@ tests/roseTests/ompLoweringTests/Makefile
 tests/roseTests/ompLoweringTests/fortran/Makefile
 tests/roseTests/programAnalysisTests/Makefile
 tests/roseTests/programAnalysisTests/defUseAnalysisTests/Makefile
+tests/roseTests/programAnalysisTests/editDistanceTests/Makefile
 tests/roseTests/programAnalysisTests/typeTraitTests/Makefile
 tests/roseTests/programAnalysisTests/sideEffectAnalysisTests/Makefile
 tests/roseTests/programAnalysisTests/staticInterproceduralSlicingTests/Makefile
@@ -2,6 +2,7 @@
 #define ROSE_RSIM_Tools_H
 
 #include "stringify.h"          // Needed by the MemoryAccessWatcher tool
+#include "BinaryExecutionTrace.h"  // Needed by the ExecutionTracer tool
 
 #include <errno.h>
 #include <fcntl.h>
@@ -13,6 +14,65 @@
  *  source code and write similar tools as classes within your own source files, which are then registered as RSIM callbacks. */
 namespace RSIM_Tools {
 
+/** Records a compact binary execution trace.
+ *
+ *  Instructions and register writes are recorded by the concrete semantics of each thread, which this instruction callback
+ *  points at the trace writer the first time the thread executes an instruction.  Memory accesses are recorded by the
+ *  memory callback in the @p memory data member, which must be installed in the AFTER slot so that the transferred data is
+ *  known.  Instruction fetches are not recorded.  The trace writer is not thread safe, so this tool should only be used for
+ *  single-threaded specimens.  See rose::BinaryAnalysis::ExecutionTrace for how to read the trace.
+ *
+ *  Example:
+ *  @code
+ *    RSIM_Linux32 sim;
+ *    std::ofstream out("specimen.trace");
+ *    rose::BinaryAnalysis::ExecutionTrace::Writer writer(out);
+ *    ExecutionTracer tracer(writer);
+ *    sim.install_callback(&tracer);
+ *    sim.install_callback(&tracer.memory, RSIM_Callbacks::AFTER);
+ *    ... // run the specimen
+ *    writer.close();
+ *  @endcode
+ */
+class ExecutionTracer: public RSIM_Callbacks::InsnCallback {
+public:
+    /** Records the specimen's memory accesses. */
+    class MemoryTracer: public RSIM_Callbacks::MemoryCallback {
+    public:
+        rose::BinaryAnalysis::ExecutionTrace::Writer &writer;   /**< Where memory accesses are recorded. */
+
+        explicit MemoryTracer(rose::BinaryAnalysis::ExecutionTrace::Writer &writer)
+            : writer(writer) {}
+
+        virtual MemoryTracer *clone() { return this; }
+
+        virtual bool operator()(bool enabled, const Args &args) {
+            if (enabled && 0==(args.req_perms & MemoryMap::EXECUTABLE) && *args.nbytes_xfer > 0) {
+                if (args.how==MemoryMap::READABLE) {
+                    writer.memoryRead(args.va, *args.nbytes_xfer, (const uint8_t*)args.buffer);
+                } else {
+                    writer.memoryWrite(args.va, *args.nbytes_xfer, (const uint8_t*)args.buffer);
+                }
+            }
+            return enabled;
+        }
+    };
+
+    rose::BinaryAnalysis::ExecutionTrace::Writer &writer;       /**< Where the trace is recorded. */
+    MemoryTracer memory;                                        /**< Memory callback to install in the AFTER slot. */
+
+    explicit ExecutionTracer(rose::BinaryAnalysis::ExecutionTrace::Writer &writer)
+        : writer(writer), memory(writer) {}
+
+    virtual ExecutionTracer *clone() { return this; }
+
+    virtual bool operator()(bool enabled, const Args &args) {
+        if (enabled && args.thread->operators()->traceWriter() != &writer)
+            args.thread->operators()->traceWriter(&writer);
+        return enabled;
+    }
+};
+
 /** Pauses at process fork.
  *
  *  When a process forks, this callback is invoked first for the process performing the fork, and then for the new process
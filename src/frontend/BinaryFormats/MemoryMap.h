@@ -89,6 +89,27 @@ public:
     typedef Sawyer::Container::AddressMapConstraints<Sawyer::Container::AddressMap<rose_addr_t, uint8_t> > Constraints;
     typedef Sawyer::Container::AddressMapConstraints<const Sawyer::Container::AddressMap<rose_addr_t, uint8_t> > ConstConstraints;
 
+    /** Buffer that shares part of another buffer's data.
+     *
+     *  Like a StaticBuffer, except it also holds a reference to the buffer that owns the data, so the data exists at least as
+     *  long as this buffer does.  Writing to it changes the owner's data unless copy-on-write is set, in which case the memory
+     *  map copies just the shared part on the first write. */
+    class SubBuffer: public StaticBuffer {
+        Buffer::Ptr owner_;
+
+    protected:
+        SubBuffer(const Buffer::Ptr &owner, Address offset, Address size)
+            : StaticBuffer(const_cast<Value*>(owner->data()) + offset, size), owner_(owner) {}
+
+    public:
+        /** Construct a buffer for @p size values of @p owner starting at @p offset. */
+        static Buffer::Ptr instance(const Buffer::Ptr &owner, Address offset, Address size) {
+            ASSERT_not_null(owner);
+            ASSERT_require(size <= owner->available(offset));
+            return Buffer::Ptr(new SubBuffer(owner, offset, size));
+        }
+    };
+
 private:
     ByteOrder::Endianness endianness_;
 
@@ -254,6 +275,8 @@ public:
      * @li @c FILENAME: Name of file to read. The file must be readable by the user and its contents are copied into the memory
      *     map.  Once inside the memory map, the segment can be given any accessibility according to PERM.  The name of the
      *     segment will be the non-directory part of the FILENAME (e.g., on POSIX systems, the part after the final slash).
+     *     Regular files on POSIX systems are not actually copied; they're mapped privately, so writing to the segment
+     *     changes only the memory map and not the file.  Such a file must not be truncated while the map refers to it.
      *
      * @section exampes Examples
      *
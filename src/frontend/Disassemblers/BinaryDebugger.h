@@ -6,6 +6,10 @@
 namespace rose {
 namespace BinaryAnalysis {
 
+namespace ExecutionTrace {
+class Writer;
+}
+
 /** Simple debugger.
  *
  *  This class implements a very simple debugger. */
@@ -24,29 +28,36 @@ private:
     UserRegDefs userRegDefs_;                           // how registers map to user_regs_struct in <sys/user.h>
     UserRegDefs userFpRegDefs_;                         // how registers map to user_fpregs_struct in <sys/user.h>
     size_t kernelWordSize_;                             // cached width in bits of kernel's words
-    uint8_t regsPage_[512];                             // latest register information read from subordinate
-    RegPageStatus regsPageStatus_;                      // what are the contents of regPage_?
+    uint8_t regsPage_[512];                             // latest user_regs_struct read from subordinate
+    RegPageStatus regsPageStatus_;                      // REGPAGE_REGS if regsPage_ is current, else REGPAGE_NONE
+    uint8_t fpRegsPage_[512];                           // latest user_fpregs_struct read from subordinate
+    RegPageStatus fpRegsPageStatus_;                    // REGPAGE_FPREGS if fpRegsPage_ is current, else REGPAGE_NONE
+    int memFd_;                                         // open /proc/N/mem for the subordinate, or -1
 
 public:
     BinaryDebugger()
-        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE) {
+        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE),
+          fpRegsPageStatus_(REGPAGE_NONE), memFd_(-1) {
         init();
     }
 
     BinaryDebugger(int pid)
-        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE) {
+        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE),
+          fpRegsPageStatus_(REGPAGE_NONE), memFd_(-1) {
         init();
         attach(pid);
     }
 
     BinaryDebugger(const std::string &exeName)
-        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE) {
+        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE),
+          fpRegsPageStatus_(REGPAGE_NONE), memFd_(-1) {
         init();
         attach(exeName);
     }
 
     BinaryDebugger(const std::vector<std::string> &exeNameAndArgs)
-        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE) {
+        : child_(0), howDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE),
+          fpRegsPageStatus_(REGPAGE_NONE), memFd_(-1) {
         init();
         attach(exeNameAndArgs);
     }
@@ -87,7 +98,10 @@ public:
     /** Set execution address. */
     void executionAddress(rose_addr_t va);
 
-    /** Get execution address. */
+    /** Get execution address.
+     *
+     *  Unless the registers have already been read since the last step, this reads only the instruction pointer from the
+     *  subordinate, so it's cheap enough to call after every step. */
     rose_addr_t executionAddress();
 
     /** Set breakpoints. */
@@ -115,15 +129,35 @@ public:
      *
      * @code
      *  uint64_t value = debugger.readRegister(RIP).toInteger();
-     * @endcode */
+     * @endcode
+     *
+     *  The general purpose and floating-point register sets are each fetched from the subordinate at most once between
+     *  steps, so reading many registers after each step costs no more than two system calls. */
     Sawyer::Container::BitVector readRegister(const RegisterDescriptor&);
 
+    /** Read subordinate registers.
+     *
+     *  Returns the values of the specified registers in the same order. This is the same as calling @ref readRegister for
+     *  each register. */
+    std::vector<Sawyer::Container::BitVector> readRegisters(const std::vector<RegisterDescriptor>&);
+
     /** Read subordinate memory.
      *
-     *  Returns the number of bytes read. The implementation accesses the subordinate memory via proc filesystem rather than
-     *  sending PTRACE_PEEKDATA commands. This allows large areas of memory to be read efficiently. */
+     *  Returns the number of bytes read. The implementation uses <code>process_vm_readv</code> where available, or else
+     *  reads the subordinate memory via the proc filesystem, rather than sending PTRACE_PEEKDATA commands. This allows large
+     *  areas of memory to be read efficiently. */
     size_t readMemory(rose_addr_t va, size_t nBytes, uint8_t *buffer);
 
+    /** Record the addresses of executed instructions.
+     *
+     *  Single-steps the subordinate until it terminates or @p maxInsns instructions have executed, recording the address of
+     *  each instruction in the @p trace.  Each step costs only the ptrace system calls necessary to single-step and read the
+     *  instruction pointer (see @ref executionAddress).  Returns the number of instructions recorded.  The caller should close
+     *  the trace when it's done recording.
+     *
+     *  Breakpoints are ignored. */
+    size_t recordTrace(ExecutionTrace::Writer &trace, size_t maxInsns = (size_t)(-1));
+
     /** Returns true if the subordinate terminated. */
     bool isTerminated();
 
@@ -137,6 +171,12 @@ private:
     // Wait for subordinate or throw on error
     void waitForChild();
 
+    // Instruction pointer via PTRACE_PEEKUSER, which reads only one word.
+    rose_addr_t peekInstructionPointer();
+
+    // Close the subordinate's /proc/N/mem if it's open
+    void closeMemory();
+
 };
 
 } // namespace
@@ -6,12 +6,63 @@
 #include "Disassembler.h"
 #include "InstructionEnumsX86.h"
 
+#include <algorithm>
+
 namespace rose {
 namespace BinaryAnalysis {
 
 /** Disassembler for the x86 architecture.  Most of the useful disassembly methods can be found in the superclass. There's
  *  really not much reason to use this class directly or to call any of these methods directly. */
 class DisassemblerX86: public Disassembler {
+public:
+    /** Compact description of a decoded instruction.
+     *
+     *  A value type holding what linear sweeps, partitioning heuristics and similar passes usually need from an instruction
+     *  (its kind, size, bytes, prefixes, and a summary of each operand) in about a hundred bytes, without allocating any IR
+     *  nodes.  Use @ref decodeOne to fill one in and @ref buildAst to create the equivalent SgAsmX86Instruction when an AST
+     *  is actually needed. */
+    struct DecodedInstruction {
+        /** Kind of operand. */
+        enum OperandKind {
+            NO_OPERAND,                                 /**< Operand is not present. */
+            REGISTER_OPERAND,                           /**< Register reference. */
+            MEMORY_OPERAND,                             /**< Memory reference; use @ref buildAst for the address. */
+            IMMEDIATE_OPERAND                           /**< Constant, including branch targets. */
+        };
+
+        /** Summary of one operand. */
+        struct Operand {
+            uint8_t kind;                               /**< An OperandKind. */
+            uint8_t nBits;                              /**< Width of the register, memory access, or immediate. */
+            uint8_t regMajor, regMinor, regOffset, regBits; /**< Register descriptor for REGISTER_OPERAND. */
+            uint64_t value;                             /**< Value of an IMMEDIATE_OPERAND. */
+
+            Operand()
+                : kind(NO_OPERAND), nBits(0), regMajor(0), regMinor(0), regOffset(0), regBits(0), value(0) {}
+
+            /** Register referenced by a REGISTER_OPERAND. */
+            RegisterDescriptor registerDescriptor() const {
+                return RegisterDescriptor(regMajor, regMinor, regOffset, regBits);
+            }
+        };
+
+        rose_addr_t va;                                 /**< Address of the instruction. */
+        X86InstructionKind kind;                        /**< Kind of instruction. */
+        uint8_t size;                                   /**< Number of bytes, at most 15. */
+        uint8_t bytes[15];                              /**< Raw bytes of the instruction. */
+        uint8_t baseSize, operandSize, addressSize;     /**< X86InstructionSize values. */
+        uint8_t segmentOverride;                        /**< An X86SegmentRegister. */
+        uint8_t repeatPrefix;                           /**< An X86RepeatPrefix. */
+        bool lockPrefix;                                /**< True if the instruction has a lock prefix. */
+        bool unconditionalJump;                         /**< True for jmp, farjmp, ret, retf, iret, and hlt. */
+        uint8_t nOperands;                              /**< Number of operands present. */
+        Operand operands[4];                            /**< The first @p nOperands are present. */
+
+        DecodedInstruction()
+            : va(0), kind(x86_unknown_instruction), size(0), baseSize(x86_insnsize_none), operandSize(x86_insnsize_none),
+              addressSize(x86_insnsize_none), segmentOverride(x86_segreg_none), repeatPrefix(x86_repeat_none),
+              lockPrefix(false), unconditionalJump(false), nOperands(0) {}
+    };
 
 
     /*========================================================================================================================
@@ -19,11 +70,11 @@ class DisassemblerX86: public Disassembler {
      *========================================================================================================================*/
 public:
     explicit DisassemblerX86(size_t wordsize)
-        : insnSize(x86_insnsize_none), ip(0), insnbufat(0), segOverride(x86_segreg_none),
+        : insnSize(x86_insnsize_none), ip(0), insnbuf(NULL), insnbufsz(0), insnbufat(0), segOverride(x86_segreg_none),
           branchPrediction(x86_branch_prediction_none), branchPredictionEnabled(false), rexPresent(false), rexW(false), 
           rexR(false), rexX(false), rexB(false), sizeMustBe64Bit(false), operandSizeOverride(false), addressSizeOverride(false),
           lock(false), repeatPrefix(x86_repeat_none), modregrmByteSet(false), modregrmByte(0), modeField(0), rmField(0), 
-          modrm(NULL), reg(NULL), isUnconditionalJump(false) {
+          modrm(NULL), reg(NULL), isUnconditionalJump(false), decoded(NULL), regcacheDict(NULL) {
         init(wordsize);
     }
 
@@ -41,6 +92,35 @@ public:
     /** Make an unknown instruction from an exception. */
     virtual SgAsmInstruction *make_unknown_instruction(const Exception&) ROSE_OVERRIDE;
 
+    /** Decode one instruction without creating an AST.
+     *
+     *  Decodes the instruction at @p start_va like @ref disassembleOne, but describes it in @p insn instead of returning a new
+     *  SgAsmX86Instruction.  The operand expressions the decoder needs are taken from a small set of nodes owned by this
+     *  disassembler and reused for every instruction, so decoding many instructions this way neither allocates nor deletes
+     *  IR nodes.  Throws an exception if the bytes are not a valid instruction, in which case @p insn is unspecified. */
+    void decodeOne(const MemoryMap *map, rose_addr_t start_va, DecodedInstruction &insn /*out*/);
+
+    /** Decode one instruction from a buffer.
+     *
+     *  Same as the other @ref decodeOne except the instruction is read from the first @p bufsz bytes of @p buf, which are
+     *  assumed to be at address @p start_va. The bytes are not copied. */
+    void decodeOne(const uint8_t *buf, size_t bufsz, rose_addr_t start_va, DecodedInstruction &insn /*out*/);
+
+    /** Build the AST for a decoded instruction.
+     *
+     *  Returns a new instruction identical to the one @ref disassembleOne would return for the same address. */
+    SgAsmX86Instruction *buildAst(const DecodedInstruction&);
+
+    /** Decode consecutive instructions.
+     *
+     *  Performs a linear sweep over the addresses of @p where that are mapped with this disassembler's protection bits,
+     *  appending one decoded instruction per instruction address to @p insns.  Each instruction starts immediately after the
+     *  previous one; gaps in the memory map are skipped.  Bytes that don't decode to an instruction produce an
+     *  x86_unknown_instruction of size one and the sweep resumes at the next byte.  The last instruction may extend past the
+     *  end of @p where.  The specimen is read in large blocks rather than one instruction at a time, which makes this much
+     *  faster than calling @ref decodeOne for each address.  Returns the number of instructions appended. */
+    size_t linearSweep(const MemoryMap *map, const AddressInterval &where, std::vector<DecodedInstruction> &insns /*out*/);
+
 
     /*========================================================================================================================
      * Data types
@@ -49,14 +129,16 @@ private:
 
     /** Same as Disassembler::Exception except with a different constructor for ease of use in DisassemblerX86.  This
      *  constructor should be used when an exception occurs during disassembly of an instruction; it is not suitable for
-     *  errors that occur before or after (use superclass constructors for that case). */
+     *  errors that occur before or after (use superclass constructors for that case).  At most 15 bytes (the longest
+     *  possible instruction) are saved, since the instruction buffer can be a whole block during a linear sweep. */
     class ExceptionX86: public Exception {
     public:
         ExceptionX86(const std::string &mesg, const DisassemblerX86 *d)
-            : Exception(mesg, d->ip, d->insnbuf, 8*d->insnbufat)
+            : Exception(mesg, d->ip, SgUnsignedCharList(d->insnbuf, d->insnbuf+std::min(d->insnbufsz, (size_t)15)),
+                        8*d->insnbufat)
             {}
         ExceptionX86(const std::string &mesg, const DisassemblerX86 *d, size_t bit)
-            : Exception(mesg, d->ip, d->insnbuf, bit)
+            : Exception(mesg, d->ip, SgUnsignedCharList(d->insnbuf, d->insnbuf+std::min(d->insnbufsz, (size_t)15)), bit)
             {}
     };
 
@@ -72,6 +154,59 @@ private:
                 mmNone, mmF3, mm66, mmF2
         };
 
+    /** Expression nodes of one type that are reused from one instruction to the next while decoding without an AST.  The
+     *  nodes are owned by the list and deleted with it.  A copy starts out empty so that disassemblers never share nodes. */
+    template<class Node>
+    class ScratchList {
+        std::vector<Node*> nodes_;
+        size_t nUsed_;
+    public:
+        ScratchList(): nUsed_(0) {}
+        ScratchList(const ScratchList&): nUsed_(0) {}
+        ScratchList& operator=(const ScratchList&) { return *this; }
+        ~ScratchList() {
+            for (size_t i=0; i<nodes_.size(); ++i)
+                delete nodes_[i];                       // children are not deleted by the IR; they're in scratch lists too
+        }
+
+        /** Returns the next unused node, or null if all are in use, in which case the caller allocates one and inserts it. */
+        Node *next() {
+            return nUsed_ < nodes_.size() ? nodes_[nUsed_++] : NULL;
+        }
+
+        /** Takes ownership of a new node and marks it used. */
+        Node *insert(Node *node) {
+            nodes_.push_back(node);
+            ++nUsed_;
+            return node;
+        }
+
+        /** Marks all nodes unused. */
+        void rewind() {
+            nUsed_ = 0;
+        }
+    };
+
+    /** Expression nodes used by decodeOne() for operands.  They are rewound at the start of each instruction, so decoding
+     *  allocates nodes only until the lists are as large as the most complicated instruction needs. */
+    struct ScratchNodes {
+        ScratchList<SgAsmIntegerValueExpression> values;
+        ScratchList<SgAsmBinaryAdd> adds;
+        ScratchList<SgAsmBinaryMultiply> multiplies;
+        ScratchList<SgAsmMemoryReferenceExpression> memoryReferences;
+        ScratchList<SgAsmDirectRegisterExpression> directRegisters;
+        ScratchList<SgAsmIndirectRegisterExpression> indirectRegisters;
+
+        void rewind() {
+            values.rewind();
+            adds.rewind();
+            multiplies.rewind();
+            memoryReferences.rewind();
+            directRegisters.rewind();
+            indirectRegisters.rewind();
+        }
+    };
+
 
 
 
@@ -106,7 +241,7 @@ private:
 private:
     /** Constructs a register reference expression for the current data segment based on whether a segment override prefix has
      *  been encountered. */
-    SgAsmExpression *currentDataSegment() const;
+    SgAsmExpression *currentDataSegment();
 
     /** Returns the size of instruction addresses. The effective address size is normally based on the default instruction
      *  size. However, if the disassembler encounters the 0x67 instruction prefix ("Address-size Override Prefix") as
@@ -172,6 +307,38 @@ private:
                                          SgAsmExpression *op1=NULL, SgAsmExpression *op2=NULL,
                                          SgAsmExpression *op3=NULL, SgAsmExpression *op4=NULL);
 
+    /** Describes the instruction in the @ref decoded data member instead of creating it and returns null. The operands are
+     *  scratch nodes and are left for the next instruction. Called by makeInstruction. */
+    SgAsmX86Instruction *makeDecodedInstruction(X86InstructionKind kind, SgAsmExpression *op1, SgAsmExpression *op2,
+                                                SgAsmExpression *op3, SgAsmExpression *op4);
+
+    /** Constructs an integer of the specified type. While decoding without an AST the node is a reused scratch node. */
+    SgAsmIntegerValueExpression *makeIntegerValue(uint64_t value, SgAsmType *type);
+
+    /** Constructs an integer the same way as SageBuilderAsm::buildValueX86Byte and its siblings, but see makeIntegerValue.
+     * @{ */
+    SgAsmIntegerValueExpression *makeByteValue(uint8_t value);
+    SgAsmIntegerValueExpression *makeWordValue(uint16_t value);
+    SgAsmIntegerValueExpression *makeDWordValue(uint32_t value);
+    SgAsmIntegerValueExpression *makeQWordValue(uint64_t value);
+    /** @} */
+
+    /** Constructs a sum or product the same way as SageBuilderAsm::buildAddExpression and buildMultiplyExpression, but reuses
+     *  a scratch node while decoding without an AST.
+     * @{ */
+    SgAsmBinaryAdd *makeAdd(SgAsmExpression *lhs, SgAsmExpression *rhs);
+    SgAsmBinaryMultiply *makeMultiply(SgAsmExpression *lhs, SgAsmExpression *rhs);
+    /** @} */
+
+    /** Constructs a memory reference the same way as SageBuilderAsm::buildMemoryReferenceExpression, but reuses a scratch node
+     *  while decoding without an AST. */
+    SgAsmMemoryReferenceExpression *makeMemoryReference(SgAsmExpression *address, SgAsmExpression *segment,
+                                                        SgAsmType *type=NULL);
+
+    /** Constructs a register reference expression for a register that is not part of a register stack. While decoding
+     *  without an AST the node is a reused scratch node. */
+    SgAsmDirectRegisterExpression *makeDirectRegister(const RegisterDescriptor&);
+
     /** Constructs a register reference expression for the instruction pointer register. */
     SgAsmRegisterReferenceExpression *makeIP();
 
@@ -183,7 +350,7 @@ private:
 
     /** Constructs a register reference expression. The @p registerType is only used for vector registers that can have more
      *  than one type. */
-    SgAsmRegisterReferenceExpression *makeRegister(uint8_t fullRegisterNumber, RegisterMode, SgAsmType *registerType=NULL) const;
+    SgAsmRegisterReferenceExpression *makeRegister(uint8_t fullRegisterNumber, RegisterMode, SgAsmType *registerType=NULL);
 
     /* FIXME: documentation? */
     SgAsmRegisterReferenceExpression *makeRegisterEffective(uint8_t fullRegisterNumber) {
@@ -196,7 +363,7 @@ private:
     }
 
     /** Constructs a register reference expression for a segment register. */
-    SgAsmExpression *makeSegmentRegister(X86SegmentRegister so, bool insn64) const;
+    SgAsmExpression *makeSegmentRegister(X86SegmentRegister so, bool insn64);
 
 
 
@@ -365,7 +532,8 @@ private:
     /** Resets disassembler state to beginning of an instruction for disassembly. */
     void startInstruction(rose_addr_t start_va, const uint8_t *buf, size_t bufsz) {
         ip = start_va;
-        insnbuf = SgUnsignedCharList(buf, buf+bufsz);
+        insnbuf = buf;
+        insnbufsz = bufsz;
         insnbufat = 0;
 
         /* Prefix flags */
@@ -389,7 +557,8 @@ private:
 
     /* Per-instruction settings; see startInstruction() */
     uint64_t ip;                                /**< Virtual address for start of instruction */
-    SgUnsignedCharList insnbuf;                 /**< Buffer containing bytes of instruction */
+    const uint8_t *insnbuf;                     /**< Buffer containing bytes of instruction; not owned by the disassembler */
+    size_t insnbufsz;                           /**< Number of bytes in insnbuf */
     size_t insnbufat;                           /**< Index of next byte to be read from or write to insnbuf */
 
     /* Temporary flags set by the instruction; initialized by startInstruction() */
@@ -410,6 +579,15 @@ private:
     SgAsmExpression *modrm;                     /**< Register or memory ref expr built from modregrmByte; see getModRegRM() */
     SgAsmExpression *reg;                       /**< Register reference expression built from modregrmByte; see getModRegRM() */
     bool isUnconditionalJump;                   /**< True for jmp, farjmp, ret, retf, iret, and hlt */
+
+    /* Set only during decodeOne() */
+    DecodedInstruction *decoded;                /**< Where makeInstruction describes the instruction instead of creating it */
+    ScratchNodes scratch;                       /**< Operand expressions reused while decoded is set */
+
+    /* Register descriptors already looked up by makeRegister(), indexed by RegisterMode and register number. Invalid
+     * descriptors have not been looked up yet. The cache belongs to regcacheDict and is cleared when the dictionary changes. */
+    RegisterDescriptor regcache[rmReturnNull][16];
+    const RegisterDictionary *regcacheDict;
 };
 
 } // namespace
@@ -130,6 +130,10 @@ class AttachPreprocessingInfoTreeTrav
       // include files (except should specified using exclusion lists via the command line).
          bool processAllIncludeFiles;
 
+      // Comments and CPP directives collected from header files (keyed by filename and preprocessing options), shared
+      // across the traversals of all source files of one frontend run so that commonly included headers are only lexed once.
+         static std::map<std::string, ROSEAttributesList*> headerFileAttributeCache;
+
      public:
        // DQ (9/24/2007): Moved function definition to source file from header file.
        // AS(011306) Constructor for use of Wave Preprocessor
@@ -178,6 +182,12 @@ class AttachPreprocessingInfoTreeTrav
        // DQ (11/30/2008): Refactored code to isolate this from the inherited attribute evaluation.
        // static ROSEAttributesList* buildCommentAndCppDirectiveList ( SgFile *currentFilePtr, std::map<std::string,ROSEAttributesList*>* mapOfAttributes, bool use_Wave );
           ROSEAttributesList* buildCommentAndCppDirectiveList ( bool use_Wave, std::string currentFilename );
+
+       // Same as buildCommentAndCppDirectiveList(), but header files are lexed only once (see headerFileAttributeCache).
+          ROSEAttributesList* getCachedCommentAndCppDirectiveList ( bool isHeaderFile, std::string currentFilename );
+
+       // Release the comments and CPP directives cached for header files (called when the outermost frontend run returns).
+          static void clearHeaderFileAttributeCache();
    };
 
 #endif
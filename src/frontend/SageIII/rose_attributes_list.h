@@ -499,6 +499,12 @@ class ROSEAttributesList
        // directives, these will be considered equivalent to the input source filename.
           std::set<int> filenameIdSet;
 
+       // Line numbers of the entries in attributeList, cached so that the weaving of comments and CPP directives into the
+       // AST can binary search the list instead of scanning it from the start index for each located node.  The index is
+       // rebuilt whenever its size no longer matches that of attributeList (or after invalidateLineNumberIndex()).
+          std::vector<int> lineNumberIndex;
+          bool lineNumberIndexIsSorted;
+
        // DQ (1/15/2015): Adding support for token-based unparsing. When new comments and CPP directives are added we need
        // to record these as a kind of transformation that will trigger the token stream representation to NOT be used and
        // the comments and CPP directives unparsed from the AST seperately from the associated IR node being unparsed from
@@ -590,6 +596,18 @@ class ROSEAttributesList
        // DQ (9/29/2013): Added to support adding processed CPP directives and comments as tokens to token list.
           PreprocessingInfo* lastElement();
 
+       // Returns the index of the first element at or after startIndex whose line number is greater than lineNumber (or
+       // size() if there is none).  When the list is not sorted by line number this returns size() so that callers fall
+       // back to a linear scan.  This is O(log n) using the cached line number index.
+          int upperBoundOfLineNumber( int startIndex, int lineNumber );
+
+       // Discard the cached line number index (required if elements are modified in place through getList()).
+          void invalidateLineNumberIndex();
+
+       // Deep copy of the PreprocessingInfo objects in this list (the raw token stream is not copied).  This is used
+       // to share the comments and CPP directives collected from a header file across the source files including it.
+          ROSEAttributesList* copyOfPreprocessingInfoList();
+
        // DQ (1/15/2015): Adding support for token-based unparsing. Access function for new data member.
        // bool isTransformation() const;
        // void setAsTransformation();
@@ -185,6 +185,21 @@ struct hash_nodeptr
 // SgSymbol *lookupSymbolInParentScopes (const SgName & name, SgScopeStatement *currentScope, SgTemplateParameterPtrList* templateParameterList, SgTemplateArgumentPtrList* templateArgumentList);
    ROSE_DLL_API SgSymbol *lookupSymbolInParentScopes (const SgName & name, SgScopeStatement *currentScope = NULL, SgTemplateParameterPtrList* templateParameterList = NULL, SgTemplateArgumentPtrList* templateArgumentList = NULL);
 
+   //! Enable or disable caching of lookupSymbolInParentScopes() results (disabled by default).
+   /*! Cached results are keyed by starting scope and name, and are invalidated when a symbol of that name is inserted
+       into or removed from any symbol table (see SgSymbolTable::get_version()), and all of them are invalidated when any
+       symbol table is deleted (deleting a scope deletes its table). Lookups with template parameters or arguments are
+       not cached. Moving a scope to a new parent is not tracked; call clearSymbolLookupCache() after such
+       transformations. */
+   ROSE_DLL_API void setSymbolLookupCacheEnabled(bool enabled);
+   ROSE_DLL_API bool isSymbolLookupCacheEnabled();
+
+   //! Discard all cached lookupSymbolInParentScopes() results.
+   ROSE_DLL_API void clearSymbolLookupCache();
+
+   //! Number of cached lookups that were answered from the cache and that had to walk the scope chain.
+   ROSE_DLL_API void getSymbolLookupCacheStatistics(size_t & hits, size_t & misses);
+
    // DQ (11/24/2007): Functions moved from the Fortran support so that they could be called from within astPostProcessing.
    //!look up the first matched function symbol in parent scopes given only a function name, starting from top of ScopeStack if currentscope is not given or NULL
    ROSE_DLL_API SgFunctionSymbol *lookupFunctionSymbolInParentScopes (const SgName & functionName, SgScopeStatement *currentScope=NULL);
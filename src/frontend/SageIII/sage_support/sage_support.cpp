@@ -1856,6 +1856,32 @@ SgProject::RunFrontend()
   return status_of_function;
 }//SgProject::RunFrontend
 
+namespace
+   {
+  // Releases the comments and CPP directives cached for header files when the outermost frontend entry point returns
+  // (SgProject::parse(), or SgFile::callFrontEnd() when a file is built outside of a project parse, e.g. by
+  // SageBuilder::buildFile()), so that the cache never outlives the frontend run that filled it.  Headers may change, or
+  // be parsed with other options, by a later run.
+     class HeaderFileAttributeCacheGuard
+        {
+          static int depth;
+
+          public:
+               HeaderFileAttributeCacheGuard()
+                  {
+                    depth++;
+                  }
+
+               ~HeaderFileAttributeCacheGuard()
+                  {
+                    if (--depth == 0)
+                         AttachPreprocessingInfoTreeTrav::clearHeaderFileAttributeCache();
+                  }
+        };
+
+     int HeaderFileAttributeCacheGuard::depth = 0;
+   }
+
 int
 SgProject::parse()
    {
@@ -1864,6 +1890,8 @@ SgProject::parse()
   // DQ (7/6/2005): Introduce tracking of performance of ROSE.
      TimingPerformance timer ("AST (SgProject::parse()):");
 
+     HeaderFileAttributeCacheGuard headerFileAttributeCacheGuard;
+
   // ROSE_ASSERT (p_fileList != NULL);
 
 #ifdef ROSE_BUILD_FORTRAN_LANGUAGE_SUPPORT
@@ -2389,6 +2417,8 @@ extern int x10_main(int argc, char** argv);
 int
 SgFile::callFrontEnd()
    {
+     HeaderFileAttributeCacheGuard headerFileAttributeCacheGuard;
+
      if (SgProject::get_verbose() > 0)
         {
           std::cout << "[INFO] [SgFile::callFrontEnd]" << std::endl;
@@ -0,0 +1,292 @@
+#ifndef COMPACT_CFG_H
+#define COMPACT_CFG_H
+
+#include "virtualCFG.h"
+#include <Sawyer/Graph.h>
+#include <Sawyer/ThreadWorkers.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace VirtualCFG
+{
+
+//! A materialized control flow graph in compressed sparse row form.
+/*! The virtual CFG recomputes the edges of a node from the AST each time outEdges() or inEdges() is called, and returns
+ *  them in a newly allocated vector.  A CompactCFG walks the virtual CFG of a construct (normally a function definition)
+ *  once, numbers its nodes densely from zero in breadth-first order starting at the entry node, and stores the edges in
+ *  contiguous arrays so that successors, predecessors and edge conditions can be iterated without allocation.  The
+ *  original nodes and edges remain available through node() and edge().
+ *
+ *  NodeT and EdgeT select the view of the CFG: the full CFG (CFGNode, CFGEdge) or a filtered one (e.g. InterestingNode,
+ *  InterestingEdge, or DataflowNode, DataflowEdge).  The graph is a snapshot; it must be rebuilt after the AST is
+ *  modified.
+ *
+ *  A graph can also be built backward, following the in-edges of the CFG, for analyses that propagate information from
+ *  the end of a construct toward its beginning.  In a backward graph successors() are the CFG predecessors, and the
+ *  source and target of an edge ID are the CFG target and source of edge(). */
+template <class NodeT = CFGNode, class EdgeT = CFGEdge>
+class CompactCFG
+   {
+     public:
+          typedef unsigned int VertexId;
+          typedef unsigned int EdgeId;
+
+          static VertexId invalidVertex() { return (VertexId)(-1); }
+
+       //! A contiguous range of vertex IDs (successors or predecessors of a vertex).
+          class VertexRange
+             {
+               const VertexId* begin_;
+               const VertexId* end_;
+               public:
+                    VertexRange(const VertexId* begin, const VertexId* end): begin_(begin), end_(end) {}
+                    const VertexId* begin() const { return begin_; }
+                    const VertexId* end() const { return end_; }
+                    size_t size() const { return end_ - begin_; }
+                    bool empty() const { return begin_ == end_; }
+                    VertexId operator[](size_t i) const { return begin_[i]; }
+             };
+
+       //! A contiguous range of edge IDs, [first, second).
+          typedef std::pair<EdgeId, EdgeId> EdgeRange;
+
+       //! Which CFG edges are followed when the graph is built.
+          enum Direction { FORWARD, BACKWARD };
+
+          CompactCFG(): entry_(invalidVertex()), exit_(invalidVertex()) {}
+
+       //! Builds the CFG of the construct rooted at root (e.g. a SgFunctionDefinition).
+          explicit CompactCFG(SgNode* root): entry_(invalidVertex()), exit_(invalidVertex()) { build(root); }
+
+          void build(SgNode* root);
+
+       //! Builds the graph of the nodes reachable from starts in the given direction.
+       /*! The starts are numbered first, in order, and entry() is the first of them.  exit() is invalidVertex(). */
+          void build(const std::vector<NodeT>& starts, Direction direction = FORWARD);
+
+          size_t numberOfVertices() const { return nodes_.size(); }
+          size_t numberOfEdges() const { return edges_.size(); }
+
+       //! Vertex of the node before the construct executes (or of the first start node).
+          VertexId entry() const { return entry_; }
+       //! Vertex of the node after the construct executes.
+          VertexId exit() const { return exit_; }
+
+          const NodeT& node(VertexId v) const { return nodes_[v]; }
+
+       //! Vertex of a node, or invalidVertex() if the node is not part of this CFG.  O(log n).
+          VertexId vertex(const NodeT& node) const
+             {
+               typename std::vector<std::pair<NodeT, VertexId> >::const_iterator i =
+                    std::lower_bound(index_.begin(), index_.end(), std::make_pair(node, (VertexId)0), CompareNodes());
+               return (i != index_.end() && i->first == node) ? i->second : invalidVertex();
+             }
+
+          VertexRange successors(VertexId v) const
+             { return VertexRange(targets_.empty() ? NULL : &targets_[0] + outOffsets_[v],
+                                  targets_.empty() ? NULL : &targets_[0] + outOffsets_[v+1]); }
+
+          VertexRange predecessors(VertexId v) const
+             { return VertexRange(sources_.empty() ? NULL : &sources_[0] + inOffsets_[v],
+                                  sources_.empty() ? NULL : &sources_[0] + inOffsets_[v+1]); }
+
+       //! Outgoing edges of v; edge IDs are consecutive.
+          EdgeRange outEdges(VertexId v) const { return EdgeRange(outOffsets_[v], outOffsets_[v+1]); }
+
+       //! Number of incoming edges of v, and the ID of the i'th one.
+          size_t numberOfInEdges(VertexId v) const { return inOffsets_[v+1] - inOffsets_[v]; }
+          EdgeId inEdge(VertexId v, size_t i) const { return inEdges_[inOffsets_[v] + i]; }
+
+          VertexId source(EdgeId e) const { return edgeSources_[e]; }
+          VertexId target(EdgeId e) const { return targets_[e]; }
+          EdgeConditionKind condition(EdgeId e) const { return (EdgeConditionKind)conditions_[e]; }
+          const EdgeT& edge(EdgeId e) const { return edges_[e]; }
+
+       //! Vertices reachable from the entry in reverse postorder (a good iteration order for forward dataflow).
+          std::vector<VertexId> reversePostOrder() const
+             { return entry_ == invalidVertex() ? std::vector<VertexId>() :
+                                                  reversePostOrder(std::vector<VertexId>(1, entry_), invalidVertex()); }
+
+       //! Vertices reachable from roots in reverse postorder.  The search does not go through stop.
+          std::vector<VertexId> reversePostOrder(const std::vector<VertexId>& roots, VertexId stop) const;
+
+     private:
+          struct CompareNodes
+             {
+               bool operator()(const std::pair<NodeT, VertexId>& a, const std::pair<NodeT, VertexId>& b) const
+                  { return a.first < b.first; }
+             };
+
+          std::vector<NodeT> nodes_;
+          std::vector<std::pair<NodeT, VertexId> > index_;       // sorted by node, for vertex()
+          std::vector<EdgeT> edges_;                             // by edge ID
+          std::vector<VertexId> outOffsets_;                     // numberOfVertices()+1 entries into targets_
+          std::vector<VertexId> targets_;                        // by edge ID
+          std::vector<VertexId> edgeSources_;                    // by edge ID
+          std::vector<unsigned char> conditions_;                // by edge ID
+          std::vector<VertexId> inOffsets_;                      // numberOfVertices()+1 entries into sources_/inEdges_
+          std::vector<VertexId> sources_;
+          std::vector<EdgeId> inEdges_;
+          VertexId entry_;
+          VertexId exit_;
+   };
+
+template <class NodeT, class EdgeT>
+void
+CompactCFG<NodeT, EdgeT>::build(SgNode* root)
+   {
+     assert(root != NULL);
+     build(std::vector<NodeT>(1, NodeT(cfgBeginningOfConstruct(root))), FORWARD);
+     exit_ = vertex(NodeT(cfgEndOfConstruct(root)));
+   }
+
+template <class NodeT, class EdgeT>
+void
+CompactCFG<NodeT, EdgeT>::build(const std::vector<NodeT>& starts, Direction direction)
+   {
+     *this = CompactCFG();
+     if (starts.empty())
+          return;
+
+  // Breadth-first numbering.  Edges are appended in vertex order, so the out-edges of vertex v are contiguous and the
+  // offsets can be recorded as we go.
+     std::map<NodeT, VertexId> ids;
+     for (size_t i = 0; i < starts.size(); ++i)
+        {
+          if (ids.insert(std::make_pair(starts[i], (VertexId)nodes_.size())).second)
+               nodes_.push_back(starts[i]);
+        }
+     entry_ = 0;
+
+     for (VertexId v = 0; v < nodes_.size(); ++v)
+        {
+          outOffsets_.push_back(targets_.size());
+          std::vector<EdgeT> out = direction == FORWARD ? nodes_[v].outEdges() : nodes_[v].inEdges();
+          for (size_t i = 0; i < out.size(); ++i)
+             {
+               NodeT tgt = direction == FORWARD ? out[i].target() : out[i].source();
+               typename std::map<NodeT, VertexId>::iterator found = ids.find(tgt);
+               VertexId t;
+               if (found == ids.end())
+                  {
+                    t = nodes_.size();
+                    ids.insert(std::make_pair(tgt, t));
+                    nodes_.push_back(tgt);
+                  }
+                 else
+                  {
+                    t = found->second;
+                  }
+               edges_.push_back(out[i]);
+               targets_.push_back(t);
+               edgeSources_.push_back(v);
+               conditions_.push_back((unsigned char)out[i].condition());
+             }
+        }
+     outOffsets_.push_back(targets_.size());
+
+     index_.assign(ids.begin(), ids.end());
+
+  // Incoming edges by counting sort on the target.
+     size_t nVertices = nodes_.size();
+     inOffsets_.assign(nVertices + 1, 0);
+     for (EdgeId e = 0; e < targets_.size(); ++e)
+          ++inOffsets_[targets_[e] + 1];
+     for (size_t v = 0; v < nVertices; ++v)
+          inOffsets_[v+1] += inOffsets_[v];
+     sources_.resize(targets_.size());
+     inEdges_.resize(targets_.size());
+     std::vector<VertexId> fill(inOffsets_.begin(), inOffsets_.end() - 1);
+     for (EdgeId e = 0; e < targets_.size(); ++e)
+        {
+          VertexId slot = fill[targets_[e]]++;
+          sources_[slot] = edgeSources_[e];
+          inEdges_[slot] = e;
+        }
+   }
+
+template <class NodeT, class EdgeT>
+std::vector<typename CompactCFG<NodeT, EdgeT>::VertexId>
+CompactCFG<NodeT, EdgeT>::reversePostOrder(const std::vector<VertexId>& roots, VertexId stop) const
+   {
+     std::vector<VertexId> result;
+     result.reserve(nodes_.size());
+
+  // Iterative depth-first search; each stack element is a vertex and the next successor position to explore.
+     std::vector<bool> seen(nodes_.size(), false);
+     if (stop != invalidVertex())
+          seen[stop] = true;
+     std::vector<std::pair<VertexId, VertexId> > stack;
+     for (size_t r = 0; r < roots.size(); ++r)
+        {
+          if (roots[r] == invalidVertex() || seen[roots[r]])
+               continue;
+          stack.push_back(std::make_pair(roots[r], outOffsets_[roots[r]]));
+          seen[roots[r]] = true;
+          while (!stack.empty())
+             {
+               std::pair<VertexId, VertexId>& top = stack.back();
+               if (top.second < outOffsets_[top.first + 1])
+                  {
+                    VertexId t = targets_[top.second++];
+                    if (!seen[t])
+                       {
+                         seen[t] = true;
+                         stack.push_back(std::make_pair(t, outOffsets_[t]));
+                       }
+                  }
+                 else
+                  {
+                    result.push_back(top.first);
+                    stack.pop_back();
+                  }
+             }
+        }
+     std::reverse(result.begin(), result.end());
+     return result;
+   }
+
+//! \internal Builds one CFG per work item of Sawyer::workInParallel in buildCompactCFGs().
+template <class NodeT, class EdgeT>
+struct CompactCFGBuilder
+   {
+     const std::vector<SgNode*>& roots;
+     std::vector<CompactCFG<NodeT, EdgeT> >& cfgs;
+
+     CompactCFGBuilder(const std::vector<SgNode*>& roots, std::vector<CompactCFG<NodeT, EdgeT> >& cfgs)
+        : roots(roots), cfgs(cfgs) {}
+
+     void operator()(size_t, size_t i)
+        {
+          cfgs[i].build(roots[i]);
+        }
+   };
+
+//! Builds the compact CFGs of several constructs (e.g. all function definitions) using nThreads threads.
+/*! The i'th result is the CFG of roots[i].  The AST must not be modified while the graphs are built. */
+template <class NodeT, class EdgeT>
+void
+buildCompactCFGs(const std::vector<SgNode*>& roots, std::vector<CompactCFG<NodeT, EdgeT> >& cfgs, size_t nThreads)
+   {
+     cfgs.clear();
+     cfgs.resize(roots.size());
+     CompactCFGBuilder<NodeT, EdgeT> builder(roots, cfgs);
+     if (nThreads <= 1 || roots.size() <= 1)
+        {
+          for (size_t i = 0; i < roots.size(); ++i)
+               builder(i, i);
+          return;
+        }
+
+  // The graphs are independent work items (no dependency edges).
+     Sawyer::Container::Graph<size_t> work;
+     for (size_t i = 0; i < roots.size(); ++i)
+          work.insertVertex(i);
+     Sawyer::workInParallel(work, nThreads, builder);
+   }
+
+} // namespace VirtualCFG
+
+#endif
@@ -61,9 +61,47 @@ class ROSE_DLL_API AstTests
           static unsigned int numSingleSuccs(SgNode* node);
           static bool isProblematic(SgNode* node);
 
+       //! Settings that control how runAllTests() runs the tests that are simple preorder traversals of the AST.
+       //! The default settings run each such test as its own traversal over every node (the original behavior).
+          struct TraversalTestSettings
+             {
+            // Number of threads used to run independent traversal tests concurrently (values <= 1 run them in the
+            // calling thread).  Only tests that read IR node data members run concurrently; tests that use global caches
+            // (mangled names, expression types) or the symbol tables (symbol tables, template properties) always run
+            // serially after the concurrent ones.
+               size_t nThreads;
+
+            // Run the traversal tests as one combined traversal (one visit per node for all tests) instead of one
+            // traversal per test.  Implied when nThreads > 1 or when sampling is enabled.
+               bool combineTraversals;
+
+            // Fraction of IR nodes that are checked (1.0 checks every node).  The selection depends only on the node
+            // and the seed, so a node is either checked by every traversal test or by none of them.
+               double samplingRate;
+               unsigned long samplingSeed;
+
+            // Upper limit on the number of IR nodes checked by the traversal tests (zero means no limit).
+               size_t maxSampledNodes;
+
+            // Print the time spent in each traversal test, and in each group of tests when combined.
+               bool reportTiming;
+
+               TraversalTestSettings()
+                  : nThreads(1), combineTraversals(false), samplingRate(1.0), samplingSeed(0), maxSampledNodes(0), reportTiming(false)
+                  {}
+
+               bool isCombined() const { return combineTraversals || nThreads > 1 || samplingRate < 1.0 || maxSampledNodes > 0; }
+             };
+
+       //! Settings used by runAllTests(), modifiable by tools that want cheaper AST validation.
+          static TraversalTestSettings traversalTestSettings;
+
        //! Test codes that traverse the AST
           static void runAllTests(SgProject* sageProject);
           static bool isCorrectAst(SgProject* sageProject);
+
+       //! Run the traversal based tests using the combined, parallel and/or sampling modes from traversalTestSettings.
+          static void runCombinedTraversalTests(SgProject* sageProject);
    };
 
 #ifndef SWIG
@@ -4,8 +4,11 @@
 #include "rosedll.h"
 #include "rose_override.h"
 #include <Sawyer/Attribute.h>
+#include <Sawyer/Synchronization.h>
+#include <boost/unordered_map.hpp>
 #include <list>
 #include <set>
+#include <vector>
 
 class SgNode;
 class SgNamedType;
@@ -237,8 +240,22 @@ public:
  *
  *  For additional information, including examples, see @ref attributes. */
 class ROSE_DLL_API AstAttributeMechanism {
-    // Use containment because we want to keep the original API.
-    Sawyer::Attribute::Storage<> attributes_;
+public:
+    /** Attribute identification number.
+     *
+     *  Each attribute name is registered once in the global @ref Sawyer::Attribute symbol table and thereafter identified by
+     *  this number.  Analyses that access the same attribute on many nodes should obtain the ID once with @ref
+     *  registerAttribute and use the ID-based methods, which avoid the name lookup on every access. */
+    typedef Sawyer::Attribute::Id AttributeId;
+
+private:
+    // Attributes are stored inline as (ID, value) pairs sorted by ID.  Most nodes have only a few attributes, so this uses
+    // one small allocation per container instead of a tree node plus a boost::any holder per attribute, and lookup is a
+    // search over a short contiguous array.
+    typedef std::pair<AttributeId, AstAttribute*> IdValuePair;
+    typedef std::vector<IdValuePair> AttributeList;
+    AttributeList attributes_;
+    mutable SAWYER_THREAD_TRAITS::Mutex mutex_;         // protects attributes_
 
 public:
     /** Default constructor.
@@ -281,14 +298,27 @@ public:
      *  it had commented-out code to do so. */
     ~AstAttributeMechanism();
 
+    /** Register an attribute name.
+     *
+     *  Returns the ID number for the specified attribute name, declaring the name in the global attribute symbol table if
+     *  necessary.  Unlike @ref Sawyer::Attribute::declare, registering a name more than once is not an error; every call
+     *  with the same name returns the same ID.
+     *
+     *  Thread safety: This method is thread safe. */
+    static AttributeId registerAttribute(const std::string &name);
+
     /** Test for attribute existence.
      *
      *  Test whether this container holds an attribute with the specified name.  This predicate returns true only if the name
      *  exists and points to a non-null attribute value.  The name need not be declared in the attribute system.
      *
      *  <b>New semantics:</b> It is now permissible to invoke this method on a const attribute container and this method no
-     *  longer copies the name argument. */
+     *  longer copies the name argument.
+     *
+     * @{ */
     bool exists(const std::string &name) const;
+    bool exists(AttributeId id) const;
+    /** @} */
 
     /** Insert an attribute.
      *
@@ -305,8 +335,12 @@ public:
      *
      *  <b>New semantics:</b> The old implementation didn't delete the previous attribute value.  The old implementation
      *  allowed setting a null value, in which case the old @c exists returned true but the @c operator[] returned no
-     *  attribute. */
+     *  attribute.
+     *
+     * @{ */
     void set(const std::string &name, AstAttribute *value);
+    void set(AttributeId id, AstAttribute *value);
+    /** @} */
 
     /** Insert a new value if the attribute doesn't already exist.
      *
@@ -317,8 +351,12 @@ public:
      *  ownership of an attribute that wasn't inserted, but it also didn't indicate whether it was inserted.  The old
      *  implementation printed an error message on standard error if the attribute existed (even if only its name existed but
      *  it had no value) and then returned to the caller without doing anything. Inserting a null value was allowed by the old
-     *  implementation, in which case the old @c exists returned true but the old @c operator[] returned no attribute. */
+     *  implementation, in which case the old @c exists returned true but the old @c operator[] returned no attribute.
+     *
+     * @{ */
     bool add(const std::string &name, AstAttribute *value);
+    bool add(AttributeId id, AstAttribute *value);
+    /** @} */
 
     /** Insert a new value if the attribute already exists.
      *
@@ -329,8 +367,12 @@ public:
      *  ownership of an attribute that wasn't inserted, but it also didn't indicate whether it was inserted. The old
      *  implementation printed an error message on standard error if the attribute didn't exist and then returned to the caller
      *  without doing anything. Inserting a null value was allowed by the old implementation, in which case the old @c exists
-     *  returned true but the old @c operator[] returned no attribute. */
+     *  returned true but the old @c operator[] returned no attribute.
+     *
+     * @{ */
     bool replace(const std::string &name, AstAttribute *value);
+    bool replace(AttributeId id, AstAttribute *value);
+    /** @} */
 
     /** Get an attribute value.
      *
@@ -344,8 +386,12 @@ public:
      *
      *  <b>New semantics:</b> The old implementation partly created an attribute if it didn't exist: @c exists started
      *  returning true although @c operator[] continued to return no attribute. The old implementation printed an error message
-     *  to standard error if the attribute did not exist. */
+     *  to standard error if the attribute did not exist.
+     *
+     * @{ */
     AstAttribute* operator[](const std::string &name) const;
+    AstAttribute* operator[](AttributeId id) const;
+    /** @} */
 
     /** Erases the specified attribute.
      *
@@ -355,12 +401,22 @@ public:
      *  after this method returns.
      *
      *  <b>New semantics:</b> The old implementation did not delete the attribute value. It also printed an error message
-     *  to standard error if the attribute did not exist. */
+     *  to standard error if the attribute did not exist.
+     *
+     * @{ */
     void remove(const std::string &name);
+    void remove(AttributeId id);
+    /** @} */
 
     /** Set of attribute names. */
     typedef std::set<std::string> AttributeIdentifiers;
 
+    /** List of stored attribute ID numbers.
+     *
+     *  Returns the ID numbers of the attributes stored in this container in ascending order. This is the ID-based equivalent
+     *  of @ref getAttributeIdentifiers and does not look up any names. */
+    std::vector<AttributeId> getAttributeIds() const;
+
     /** List of stored attribute names.
      *
      *  Returns the set of names for attributes stored in this container. This can be used to iterate over the attributes,
@@ -388,6 +444,149 @@ public:
 private:
     // Called by copy constructor and assignment.
     void assignFrom(const AstAttributeMechanism &other);
+
+    // Value for the specified ID, or null.  Caller must hold the mutex.
+    AstAttribute* findNS(AttributeId id) const;
+
+    // Store (or erase if null) the value for the specified ID, returning the previous value. Caller must hold the mutex.
+    AstAttribute* storeNS(AttributeId id, AstAttribute *value);
+};
+
+
+/** Stores one attribute type densely, outside the IR nodes.
+ *
+ *  An analysis that attaches the same kind of value to a large number of nodes (e.g., to every expression) pays for a
+ *  heap-allocated @ref AstAttribute per node plus the per-node container when it uses @ref AstAttributeMechanism.  A side
+ *  table instead stores the values themselves (not pointers to polymorphic attributes) contiguously in a single array owned by
+ *  the analysis, with a hash index from node to array slot.  Nothing is stored in the nodes, so the table can be discarded
+ *  in one step when the analysis is finished.
+ *
+ *  Unlike attributes in an @ref AstAttributeMechanism, values in a side table are not copied when the AST is copied, are not
+ *  written by AST file I/O, and are not removed when a node is deleted; the table's owner is responsible for those things.
+ *
+ *  The value type must be copyable and default-constructible.  Erasing a value moves the last value into the vacated slot,
+ *  therefore pointers returned by @ref find are invalidated by @ref insert and @ref erase. */
+template<class T>
+class AstAttributeSideTable {
+public:
+    /** Type of values stored in the table. */
+    typedef T Value;
+
+private:
+    typedef boost::unordered_map<const SgNode*, size_t> Index;
+    Index index_;                                       // node to position in nodes_ and values_
+    std::vector<const SgNode*> nodes_;                  // node for each value, parallel to values_
+    std::vector<Value> values_;                         // the values, stored densely
+
+public:
+    /** Number of nodes that have a value. */
+    size_t size() const {
+        return values_.size();
+    }
+
+    /** True if no node has a value. */
+    bool isEmpty() const {
+        return values_.empty();
+    }
+
+    /** Reserve space for the specified number of values. */
+    void reserve(size_t n) {
+        index_.rehash(n);
+        nodes_.reserve(n);
+        values_.reserve(n);
+    }
+
+    /** Test whether a node has a value. */
+    bool exists(const SgNode *node) const {
+        return index_.find(node) != index_.end();
+    }
+
+    /** Store a value for a node, replacing any previous value. */
+    void insert(const SgNode *node, const Value &value) {
+        std::pair<typename Index::iterator, bool> inserted = index_.insert(std::make_pair(node, values_.size()));
+        if (inserted.second) {
+            nodes_.push_back(node);
+            values_.push_back(value);
+        } else {
+            values_[inserted.first->second] = value;
+        }
+    }
+
+    /** Store a value for a node if it doesn't have one already. Returns true if the value was stored. */
+    bool insertMaybe(const SgNode *node, const Value &value) {
+        if (exists(node))
+            return false;
+        insert(node, value);
+        return true;
+    }
+
+    /** Pointer to the value for a node, or null if the node has no value.
+     *
+     * @{ */
+    Value* find(const SgNode *node) {
+        typename Index::const_iterator found = index_.find(node);
+        return found == index_.end() ? NULL : &values_[found->second];
+    }
+    const Value* find(const SgNode *node) const {
+        typename Index::const_iterator found = index_.find(node);
+        return found == index_.end() ? NULL : &values_[found->second];
+    }
+    /** @} */
+
+    /** Value for a node, or the specified default if the node has no value. */
+    Value getOrElse(const SgNode *node, const Value &dflt) const {
+        const Value *found = find(node);
+        return found ? *found : dflt;
+    }
+
+    /** Value for a node, inserting a default-constructed value if necessary. */
+    Value& operator[](const SgNode *node) {
+        typename Index::const_iterator found = index_.find(node);
+        if (found != index_.end())
+            return values_[found->second];
+        insert(node, Value());
+        return values_.back();
+    }
+
+    /** Remove the value for a node. Returns true if the node had a value. */
+    bool erase(const SgNode *node) {
+        typename Index::iterator found = index_.find(node);
+        if (found == index_.end())
+            return false;
+        size_t slot = found->second;
+        index_.erase(found);
+        if (slot + 1 != values_.size()) {
+            nodes_[slot] = nodes_.back();
+            values_[slot] = values_.back();
+            index_[nodes_[slot]] = slot;
+        }
+        nodes_.pop_back();
+        values_.pop_back();
+        return true;
+    }
+
+    /** Remove all values. */
+    void clear() {
+        index_.clear();
+        nodes_.clear();
+        values_.clear();
+    }
+
+    /** Nodes that have values, parallel to @ref values. */
+    const std::vector<const SgNode*>& nodes() const {
+        return nodes_;
+    }
+
+    /** Stored values, parallel to @ref nodes.
+     *
+     * @{ */
+    const std::vector<Value>& values() const {
+        return values_;
+    }
+    std::vector<Value>& values() {
+        return values_;
+    }
+    /** @} */
 };
 
 
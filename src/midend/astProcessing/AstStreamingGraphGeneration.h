@@ -0,0 +1,83 @@
+#ifndef AST_STREAMING_GRAPH_GENERATION_H
+#define AST_STREAMING_GRAPH_GENERATION_H
+
+#include <string>
+#include <vector>
+#include "roseInternal.h"
+
+class SgNode;
+class SgProject;
+
+/** Writes graphs of large ASTs.
+ *
+ *  Unlike AstDOTGeneration, which builds the whole graph in memory before writing one file, this generator partitions the
+ *  AST into one subgraph per file or per function, streams each subgraph directly to its own output file without
+ *  intermediate string maps, and writes the subgraphs in parallel.  Each subgraph can be bounded by a node budget and a
+ *  depth budget; subtrees beyond the budget are replaced by a single elided node so that the output remains a valid
+ *  graph.
+ *
+ *  Besides DOT, subgraphs can be written in a compact binary format meant for external renderers. A binary file starts
+ *  with the four bytes "RAGB" followed by a 32-bit format version, and is then a sequence of node records, all integers
+ *  being little-endian:
+ *
+ *  @code
+ *    uint32  parent      index of the parent node record, or 0xffffffff for the root
+ *    uint16  variant     VariantT of the node, or 0xffff for an elided subtree
+ *    uint16  childIndex  position of the node among the traversal successors of its parent
+ *    uint32  labelSize   number of bytes that follow (declaration name or edge name of an elided subtree)
+ *    char    label[labelSize]
+ *  @endcode
+ *
+ *  Records appear in preorder, so a node's parent always precedes it. */
+class ROSE_DLL_API AstStreamingGraphGeneration
+   {
+     public:
+          enum OutputFormat { DOT_FORMAT, BINARY_FORMAT };
+
+       // How the AST is partitioned into subgraphs.
+          enum Partitioning { PER_FILE, PER_FUNCTION };
+
+          struct Settings
+             {
+               OutputFormat format;
+               Partitioning partitioning;
+
+            // Maximum number of nodes per subgraph, or zero for no limit.  Nodes standing for elided subtrees count
+            // toward this limit.
+               size_t maxNodes;
+
+            // Maximum depth below the root of each subgraph, or zero for no limit.
+               size_t maxDepth;
+
+            // Number of threads writing subgraphs concurrently (zero means use the hardware concurrency).
+               size_t nThreads;
+
+            // Prefix for the generated file names (e.g. a directory name ending with '/').
+               std::string outputPrefix;
+
+            // Skip the declarations ROSE adds for GNU compatibility (as AstDOTGeneration does).
+               bool skipFrontendSpecificNodes;
+
+               Settings()
+                  : format(DOT_FORMAT), partitioning(PER_FILE), maxNodes(0), maxDepth(0), nThreads(1),
+                    skipFrontendSpecificNodes(true)
+                  {}
+             };
+
+          AstStreamingGraphGeneration() {}
+          explicit AstStreamingGraphGeneration(const Settings & settings) : settings_(settings) {}
+
+          const Settings & settings() const { return settings_; }
+          Settings & settings() { return settings_; }
+
+       // Writes one subgraph per file or function of the project and returns the names of the files written.
+          std::vector<std::string> generate(SgProject* project);
+
+       // Writes the subtree rooted at node as a single subgraph to the named file. Returns the number of nodes written.
+          size_t generate(SgNode* node, const std::string & filename) const;
+
+     private:
+          Settings settings_;
+   };
+
+#endif
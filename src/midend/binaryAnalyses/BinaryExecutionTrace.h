@@ -0,0 +1,262 @@
+#ifndef ROSE_BinaryAnalysis_ExecutionTrace_H
+#define ROSE_BinaryAnalysis_ExecutionTrace_H
+
+#include <Sawyer/Map.h>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <map>
+#include <ostream>
+#include <vector>
+
+namespace rose {
+namespace BinaryAnalysis {
+
+/** Compact binary execution traces.
+ *
+ *  An execution trace is the sequence of instructions executed by a specimen, interleaved with the register writes and memory
+ *  accesses that those instructions performed.  Traces are written by a @ref Writer, which can be attached to a
+ *  @ref InstructionSemantics2::ConcreteSemantics::RiscOperators "concrete semantics" object or to the
+ *  @ref InstructionSemantics2::TraceSemantics::RiscOperators "trace semantics" wrapper of any other domain, fed by the
+ *  simulator's <code>RSIM_Tools::ExecutionTracer</code>, or filled by @ref BinaryDebugger::recordTrace. They are read by
+ *  a @ref Reader, which maps the file into memory and can split the trace into pieces that are analyzed concurrently.
+ *
+ *  The encoding is meant to be small. Each record stores the difference from the record before it, and most fall-through
+ *  instructions take a single byte. Register writes store only the change to the register. Memory accesses store the address
+ *  relative to the end of the previous access, followed by the bytes transferred.  At regular intervals the writer emits a
+ *  checkpoint that holds the complete decoder state, including the value of every register seen so far.  A reader can start
+ *  decoding at any checkpoint without looking at anything before it.  The file ends with an index of the checkpoints, so
+ *  opening a trace does not require scanning it.  A trace whose writer did not finish (e.g., because the tool crashed) has
+ *  no index and is still readable; the reader scans it once to find the checkpoints and ignores a truncated final record.
+ *
+ *  Register values are limited to 64 bits.
+ *
+ *  Here's an example that records a trace with the concrete semantics and prints the ten hottest blocks:
+ *
+ * @code
+ *  std::ofstream out("specimen.trace");
+ *  ExecutionTrace::Writer writer(out);
+ *  ops->traceWriter(&writer);
+ *  ... run the specimen with a dispatcher using ops ...
+ *  writer.close();
+ *
+ *  ExecutionTrace::Reader trace("specimen.trace");
+ *  ExecutionTrace::Histogram blocks = trace.blockHistogram();
+ * @endcode */
+namespace ExecutionTrace {
+
+/** Execution counts per address. */
+typedef Sawyer::Container::Map<rose_addr_t, size_t> Histogram;
+
+/** Kinds of events stored in a trace. */
+enum EventKind {
+    INSTRUCTION,                                        /**< An instruction was executed. */
+    REGISTER_WRITE,                                     /**< A register changed value. */
+    MEMORY_READ,                                        /**< Bytes were read from memory. */
+    MEMORY_WRITE                                        /**< Bytes were written to memory. */
+};
+
+/** One event decoded from a trace. */
+struct Event {
+    EventKind kind;                                     /**< What kind of event this is. */
+    uint64_t insnCount;                                 /**< Number of instructions that precede this event in the trace. */
+    rose_addr_t address;                                /**< Address of the instruction or of the first byte accessed. */
+    size_t size;                                        /**< Instruction size (zero if unknown), or number of bytes accessed. */
+    bool fallsThrough;                                  /**< Instruction immediately follows the previous instruction. */
+    size_t registerIndex;                               /**< Register written, as an index into @ref Cursor::registers. */
+    uint64_t value;                                     /**< New value of the register. */
+    const uint8_t *bytes;                               /**< Bytes read or written. Points into the trace. */
+
+    Event()
+        : kind(INSTRUCTION), insnCount(0), address(0), size(0), fallsThrough(false), registerIndex(0), value(0), bytes(NULL) {}
+};
+
+/** Position of a checkpoint. */
+struct Checkpoint {
+    uint64_t insnCount;                                 /**< Number of instructions that precede the checkpoint. */
+    size_t offset;                                      /**< Byte offset of the checkpoint record in the trace. */
+
+    Checkpoint(): insnCount(0), offset(0) {}
+    Checkpoint(uint64_t insnCount, size_t offset): insnCount(insnCount), offset(offset) {}
+};
+
+/** Writes a trace.
+ *
+ *  Events are appended to the trace in the order they occur and are buffered internally.  The trace is not complete until
+ *  @ref close is called, which writes the checkpoint index; the destructor calls @ref close if the user didn't.  A writer is
+ *  not thread safe. */
+class Writer {
+    std::ostream &out_;
+    std::vector<uint8_t> buffer_;                       // records not yet written to out_
+    uint64_t nFlushed_;                                 // number of bytes already written to out_
+    uint64_t checkpointInterval_;                       // number of instructions between checkpoints
+    uint64_t nInsns_;                                   // number of instructions recorded
+    rose_addr_t prevVa_;                                // address of the previous instruction
+    size_t prevSize_;                                   // size of previous instruction, or zero
+    rose_addr_t nextMemVa_;                             // address following the previous memory access
+    std::map<RegisterDescriptor, size_t> registerIndex_;// index of each register in registers_
+    std::vector<RegisterDescriptor> registers_;         // registers in the order they were first written
+    std::vector<uint64_t> values_;                      // latest value of each register
+    std::vector<Checkpoint> checkpoints_;               // all checkpoints written so far
+    bool closed_;                                       // set by close()
+
+public:
+    /** Start writing a trace to the specified stream.
+     *
+     *  A checkpoint is written before every @p checkpointInterval instructions.  Smaller intervals give readers finer
+     *  positioning and more pieces to work on concurrently at the cost of a larger trace. */
+    explicit Writer(std::ostream&, uint64_t checkpointInterval = 65536);
+
+    ~Writer();
+
+    /** Record execution of an instruction.
+     *
+     *  The @p size is the instruction size in bytes, or zero if the size is unknown.  Known sizes let readers find the block
+     *  boundaries exactly and make fall-through instructions cheaper to encode. */
+    void instruction(rose_addr_t va, size_t size = 0);
+
+    /** Record a register write.
+     *
+     *  The register must not be wider than 64 bits.  Writes that don't change the register's value are not recorded. */
+    void registerWrite(const RegisterDescriptor&, uint64_t value);
+
+    /** Record bytes read from memory. */
+    void memoryRead(rose_addr_t va, size_t nBytes, const uint8_t *bytes);
+
+    /** Record bytes written to memory. */
+    void memoryWrite(rose_addr_t va, size_t nBytes, const uint8_t *bytes);
+
+    /** Finish the trace.
+     *
+     *  Writes the checkpoint index and flushes the stream. No events can be recorded after this.  Throws
+     *  <code>std::runtime_error</code> if the stream could not be written. */
+    void close();
+
+    /** Number of instructions recorded so far. */
+    uint64_t nInstructions() const { return nInsns_; }
+
+    /** Number of bytes in the trace so far. */
+    uint64_t nBytes() const { return nFlushed_ + buffer_.size(); }
+
+private:
+    void memoryAccess(uint8_t tag, rose_addr_t va, size_t nBytes, const uint8_t *bytes);
+    void checkpoint();
+    void flush();
+};
+
+/** Decodes events from part of a trace.
+ *
+ *  A cursor is obtained from a @ref Reader and decodes the events between two checkpoints.  Each cursor has its own copy of
+ *  the decoder state, so different cursors for the same reader can be used by different threads at the same time. */
+class Cursor {
+    const uint8_t *data_;                               // start of the trace
+    const uint8_t *at_;                                 // next record
+    const uint8_t *end_;                                // end of this cursor's range
+    uint64_t insnCount_;                                // instructions decoded so far, counted from the start of the trace
+    rose_addr_t prevVa_;
+    size_t prevSize_;
+    rose_addr_t nextMemVa_;
+    std::vector<RegisterDescriptor> registers_;
+    std::vector<uint64_t> values_;
+
+public:
+    /** Empty cursor. */
+    Cursor(): data_(NULL), at_(NULL), end_(NULL), insnCount_(0), prevVa_(0), prevSize_(0), nextMemVa_(0) {}
+
+    /** Cursor for the records from @p begin up to but not including @p end. The @p begin must be a checkpoint record. */
+    Cursor(const uint8_t *data, size_t begin, size_t end);
+
+    /** Decode the next event.
+     *
+     *  Returns false, leaving @p event unchanged, when there are no more events in this cursor's range. Throws
+     *  <code>std::runtime_error</code> if the trace is corrupt. */
+    bool next(Event &event);
+
+    /** Registers seen so far.
+     *
+     *  The @ref Event::registerIndex of a register write is an index into this list. */
+    const std::vector<RegisterDescriptor>& registers() const { return registers_; }
+
+    /** Register values at the current position, parallel to @ref registers. */
+    const std::vector<uint64_t>& registerValues() const { return values_; }
+
+    /** Number of instructions that precede the current position in the trace. */
+    uint64_t insnCount() const { return insnCount_; }
+
+private:
+    void loadCheckpoint();
+};
+
+/** Reads a trace.
+ *
+ *  A trace file is mapped into memory rather than being read, so opening even a very large trace is quick and the operating
+ *  system pages the parts that are used.  Events are decoded with a @ref Cursor. The analyses provided here split the trace at
+ *  its checkpoints and use multiple threads; users can do the same for their own analyses with @ref partition. */
+class Reader {
+    boost::iostreams::mapped_file_source file_;
+    const uint8_t *data_;
+    size_t size_;
+    size_t eventsEnd_;                                  // offset following the last event record
+    uint64_t nInsns_;
+    std::vector<Checkpoint> checkpoints_;
+
+public:
+    /** Open the trace stored in the specified file.
+     *
+     *  Throws <code>std::runtime_error</code> if the file is not a trace. */
+    explicit Reader(const boost::filesystem::path&);
+
+    /** Use the trace stored in memory.
+     *
+     *  The memory is not copied and must remain valid as long as the reader or any of its cursors are used. */
+    Reader(const uint8_t *data, size_t size);
+
+    /** Number of instructions in the trace. */
+    uint64_t nInstructions() const { return nInsns_; }
+
+    /** Checkpoints in the order they appear. */
+    const std::vector<Checkpoint>& checkpoints() const { return checkpoints_; }
+
+    /** Index of the last checkpoint that precedes the specified instruction. */
+    size_t findCheckpoint(uint64_t insnCount) const;
+
+    /** Cursor for all events from checkpoint @p first up to but not including checkpoint @p last.
+     *
+     *  A @p last greater than the number of checkpoints means to the end of the trace. */
+    Cursor cursor(size_t first = 0, size_t last = (size_t)(-1)) const;
+
+    /** Split the trace into consecutive pieces.
+     *
+     *  Returns at most @p nParts cursors that together cover the whole trace in order, with about the same number of
+     *  checkpoints in each. */
+    std::vector<Cursor> partition(size_t nParts) const;
+
+    /** Addresses of all instructions in the order they were executed. */
+    std::vector<rose_addr_t> instructionAddresses() const;
+
+    /** Number of times each instruction was executed.
+     *
+     *  The analysis uses @p nThreads threads, where zero means use as many threads as there is hardware concurrency. */
+    Histogram instructionHistogram(size_t nThreads = 0) const;
+
+    /** Number of times each block was entered.
+     *
+     *  A block begins with any instruction that was not reached by falling through from the instruction executed before it.
+     *  When a trace doesn't record instruction sizes, an instruction is assumed to fall through to the next one executed if
+     *  that one is less than 16 bytes after it.  See @ref instructionHistogram for @p nThreads. */
+    Histogram blockHistogram(size_t nThreads = 0) const;
+
+    /** Addresses of all executed instruction bytes.
+     *
+     *  An instruction of unknown size covers only its first byte. See @ref instructionHistogram for @p nThreads. */
+    AddressIntervalSet coverage(size_t nThreads = 0) const;
+
+private:
+    void init();
+    void scan();
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
@@ -840,7 +840,21 @@ public:
          *  length, then removes any string whose memory addresses overlap with any prior string in the list. */
         bool keepingOnlyLongest;
 
-        Settings(): minLength(5), maxLength(-1), maxOverlap(8), keepingOnlyLongest(true) {}
+        /** Number of threads.
+         *
+         *  Memory is divided into chunks that are searched concurrently by this many threads. Strings that cross from one
+         *  chunk into the next are found just as they would be by a single thread, and the results are the same and in the
+         *  same order regardless of the number of threads.  A value of zero means use the same number of threads as there
+         *  is hardware concurrency.  Searches anchored at one address (e.g., @ref MemoryMap::at) always use one thread. */
+        size_t nThreads;
+
+        /** Size of each chunk for multi-threaded searching.
+         *
+         *  Number of bytes at which strings may start in each chunk of memory searched by one thread. See @ref nThreads. */
+        size_t chunkSize;
+
+        Settings()
+            : minLength(5), maxLength(-1), maxOverlap(8), keepingOnlyLongest(true), nThreads(1), chunkSize(1024*1024) {}
     };
     
 private:
@@ -934,7 +948,8 @@ public:
      *  @ref encoders).
      *
      *  The search progresses by looking at each possible starting address using each registered encoding. The algorithm reads
-     *  each byte from memory only one time, simultaneously attempting all encoders.  If the MemoryMap constraint contains an
+     *  each byte from memory only one time, simultaneously attempting all encoders, and can divide the memory among
+     *  multiple threads (see @ref Settings::nThreads).  If the MemoryMap constraint contains an
      *  anchor point (e.g., @ref MemoryMap::at) then only strings starting at the specified address are returned.
      *
      *  Example 1: Find all C-style, NUL-terminated, ASCII strings contaiing only printable characters (no control characters)
@@ -9,12 +9,15 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/optional.hpp>
+#include <boost/thread/tss.hpp>
 #include <Sawyer/Assert.h>
 #include <Sawyer/IntervalMap.h>
 #include <Sawyer/IntervalSetMap.h>
 #include <Sawyer/Map.h>
 #include <Sawyer/Optional.h>
+#include <Sawyer/PoolAllocator.h>
 #include <Sawyer/Set.h>
+#include <Sawyer/SmallObject.h>
 
 namespace rose {
 namespace BinaryAnalysis {
@@ -516,6 +519,10 @@ Sawyer::SharedPointer<To> dynamic_pointer_cast(const Sawyer::SharedPointer<From>
 /** Shared-ownership pointer to a semantic value in any domain. See @ref heap_object_shared_ownership. */
 typedef Sawyer::SharedPointer<class SValue> SValuePtr;
 
+// Found by Sawyer::SharedPointer through argument-dependent lookup; false for values created by a thread-confined thread. It's
+// declared before any SValuePtr is copied so that every use of the pointer sees it.
+inline bool sharedOwnershipIsSynchronized(const SValue*);
+
 /** Base class for semantic values.
  *
  *  A semantic value represents a datum from the specimen being analyzed. The datum could be from memory, it could be something
@@ -530,15 +537,88 @@ typedef Sawyer::SharedPointer<class SValue> SValuePtr;
  *  Semantics value objects are allocated on the heap and reference counted.  The BaseSemantics::SValue is an abstract class
  *  that defines the interface.  See the rose::BinaryAnalysis::InstructionSemantics2 namespace for an overview of how the parts
  *  fit together.*/
-class SValue: public Sawyer::SharedObject, public Sawyer::SharedFromThis<SValue>, public Sawyer::SmallObject {
+class SValue: public Sawyer::SharedObject, public Sawyer::SharedFromThis<SValue> {
 protected:
     size_t width;                               /** Width of the value in bits. Typically (not always) a power of two. */
 
+private:
+    bool threadConfined_;                       // created while thread-confined, so its reference count isn't locked
+
+    friend bool sharedOwnershipIsSynchronized(const SValue*);
+
+    // Pool for the values created by one thread while it's thread-confined. The pool is used only by that thread, so its counter
+    // needs no lock. It's deleted once the thread no longer allocates from it (see threadConfined) and all its values are gone.
+    struct ThreadAllocator {
+        Sawyer::UnsynchronizedPoolAllocator pool;
+        size_t nValues;                         // number of values allocated from the pool and not yet deallocated
+        bool retired;                           // true once the thread no longer allocates from this pool
+        ThreadAllocator(): nValues(0), retired(false) {}
+    };
+
+    // Allocator for values created by this thread while it's thread-confined, else null.
+    static SAWYER_THREAD_LOCAL ThreadAllocator *threadAllocator_;
+
+    // The same allocator, retired when the thread exits since thread-local storage can only hold POD types.
+    static boost::thread_specific_ptr<ThreadAllocator> exitingThreadAllocator_;
+
+    // Storage for each value is preceded by a pointer to the thread allocator that owns it, or null for the shared allocator.
+    union AllocationHeader {
+        ThreadAllocator *allocator;
+        double alignment;
+    };
+
+    static void retire(ThreadAllocator*);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Normal, protected, C++ constructors
 protected:
-    explicit SValue(size_t nbits): width(nbits) {}  // hot
-    SValue(const SValue &other): width(other.width) {}
+    explicit SValue(size_t nbits): width(nbits), threadConfined_(threadAllocator_ != NULL) {} // hot
+    SValue(const SValue &other): width(other.width), threadConfined_(threadAllocator_ != NULL) {}
+
+public:
+    static void *operator new(size_t size) {        // hot
+        ThreadAllocator *allocator = threadAllocator_;
+        size += sizeof(AllocationHeader);
+        AllocationHeader *header = NULL;
+        if (allocator) {
+            header = static_cast<AllocationHeader*>(allocator->pool.allocate(size));
+            ++allocator->nValues;
+        } else {
+            header = static_cast<AllocationHeader*>(Sawyer::SmallObject::poolAllocator().allocate(size));
+        }
+        header->allocator = allocator;
+        return header + 1;
+    }
+
+    static void operator delete(void *ptr, size_t size) { // hot
+        if (ptr) {
+            AllocationHeader *header = static_cast<AllocationHeader*>(ptr) - 1;
+            size += sizeof(AllocationHeader);
+            if (ThreadAllocator *allocator = header->allocator) {
+                allocator->pool.deallocate(header, size);
+                if (0 == --allocator->nValues && allocator->retired)
+                    delete allocator;
+            } else {
+                Sawyer::SmallObject::poolAllocator().deallocate(header, size);
+            }
+        }
+    }
+
+    /** Property: Whether values are confined to the calling thread.
+     *
+     *  Values are normally allocated from a pool shared by all threads and their reference counts are protected by a mutex, so
+     *  that values can be shared between threads.  When a thread turns on confinement, the values it creates from then on are
+     *  allocated from a pool that belongs to that thread and their reference counts are not locked, which makes creating,
+     *  copying, and destroying values faster.  Such values must not be used or destroyed by any other thread, including after
+     *  confinement is turned off again.  The thread's pool is freed once confinement is turned off or the thread exits, and the
+     *  last of its values is destroyed.  This is a per-thread setting and is off by default.
+     *
+     * @{ */
+    static bool threadConfined() {
+        return threadAllocator_ != NULL;
+    }
+    static void threadConfined(bool b);
+    /** @} */
 
 public:
     /** Shared-ownership pointer for an @ref SValue object. See @ref heap_object_shared_ownership. */
@@ -725,6 +805,10 @@ public:
     /** @} */
 };
 
+inline bool sharedOwnershipIsSynchronized(const SValue *value) { // hot
+    return !value->threadConfined_;
+}
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -13,6 +13,11 @@
 
 namespace rose {
 namespace BinaryAnalysis {              // documented elsewhere
+
+namespace ExecutionTrace {
+class Writer;
+}
+
 namespace InstructionSemantics2 {       // documented elsewhere
 
 /** A concrete semantic domain.
@@ -314,17 +319,19 @@ typedef boost::shared_ptr<class RiscOperators> RiscOperatorsPtr;
  * @endcode
  */
 class RiscOperators: public BaseSemantics::RiscOperators {
+    ExecutionTrace::Writer *traceWriter_;               // optional trace of instructions, registers, and memory
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors
 protected:
     RiscOperators(const BaseSemantics::SValuePtr &protoval, SMTSolver *solver)
-        : BaseSemantics::RiscOperators(protoval, solver) {
+        : BaseSemantics::RiscOperators(protoval, solver), traceWriter_(NULL) {
         name("Concrete");
         (void) SValue::promote(protoval); // make sure its dynamic type is a ConcreteSemantics::SValue
     }
 
     RiscOperators(const BaseSemantics::StatePtr &state, SMTSolver *solver)
-        : BaseSemantics::RiscOperators(state, solver) {
+        : BaseSemantics::RiscOperators(state, solver), traceWriter_(NULL) {
         name("Concrete");
         (void) SValue::promote(state->protoval());      // values must have ConcreteSemantics::SValue dynamic type
     }
@@ -379,6 +386,20 @@ public:
         return retval;
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Properties
+public:
+    /** Property: Execution trace writer.
+     *
+     *  When non-null, every instruction, register write, and memory access processed by these operators is recorded in the
+     *  trace.  Writes to registers wider than 64 bits are not recorded.  The writer is not owned by these operators and must
+     *  outlive them or be reset to null.  See @ref ExecutionTrace.
+     *
+     * @{ */
+    ExecutionTrace::Writer* traceWriter() const { return traceWriter_; }
+    void traceWriter(ExecutionTrace::Writer *writer) { traceWriter_ = writer; }
+    /** @} */
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // New methods for constructing values, so we don't have to write so many SValue::promote calls in the RiscOperators
     // implementations.
@@ -400,6 +421,8 @@ protected:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Override methods from base class.  These are the RISC operators that are invoked by a Dispatcher.
 public:
+    virtual void startInstruction(SgAsmInstruction*) ROSE_OVERRIDE;
+    virtual void writeRegister(const RegisterDescriptor&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
     virtual void interrupt(int majr, int minr) ROSE_OVERRIDE;
     virtual BaseSemantics::SValuePtr and_(const BaseSemantics::SValuePtr &a_,
                                           const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
@@ -471,6 +494,9 @@ public:
                              const BaseSemantics::SValuePtr &cond) ROSE_OVERRIDE;
 
 protected:
+    // Record a memory access in the execution trace
+    void traceMemory(bool isWrite, const BaseSemantics::SValuePtr &address, const BaseSemantics::SValuePtr &value);
+
     // Convert expression to double
     double exprToDouble(const BaseSemantics::SValuePtr &expr, SgAsmFloatType*);
 
@@ -15,24 +15,35 @@ namespace InstructionSemantics2 {
 /** Shared-ownership pointer to an x86 instruction dispatcher. See @ref heap_object_shared_ownership. */
 typedef boost::shared_ptr<class DispatcherX86> DispatcherX86Ptr;
 
+namespace X86 {
+class InsnProcessor;
+} // namespace
+
 class DispatcherX86: public BaseSemantics::Dispatcher {
 protected:
     X86InstructionSize processorMode_;
+    std::vector<X86::InsnProcessor*> x86iprocs_;        // iproc_table entries that are X86::InsnProcessor, not owned
+    bool directDispatchKnown_;                          // has directDispatch_ been computed yet?
+    bool directDispatch_;                               // may processInstruction bypass iproc_key and iproc_lookup?
+    bool directDispatchEnabled_;                        // the directDispatch property
 
     // Prototypical constructor
     DispatcherX86()
         : BaseSemantics::Dispatcher(32, SgAsmX86Instruction::registersForInstructionSize(x86_insnsize_32)),
-          processorMode_(x86_insnsize_32) {}
+          processorMode_(x86_insnsize_32), directDispatchKnown_(false), directDispatch_(false),
+          directDispatchEnabled_(true) {}
 
     // Prototypical constructor
     DispatcherX86(size_t addrWidth, const RegisterDictionary *regs/*=NULL*/)
         : BaseSemantics::Dispatcher(addrWidth, regs ? regs : SgAsmX86Instruction::registersForWidth(addrWidth)),
-          processorMode_(SgAsmX86Instruction::instructionSizeForWidth(addrWidth)) {}
+          processorMode_(SgAsmX86Instruction::instructionSizeForWidth(addrWidth)), directDispatchKnown_(false),
+          directDispatch_(false), directDispatchEnabled_(true) {}
 
     // Normal constructor
     DispatcherX86(const BaseSemantics::RiscOperatorsPtr &ops, size_t addrWidth, const RegisterDictionary *regs)
         : BaseSemantics::Dispatcher(ops, addrWidth, regs ? regs : SgAsmX86Instruction::registersForWidth(addrWidth)),
-          processorMode_(SgAsmX86Instruction::instructionSizeForWidth(addrWidth)) {
+          processorMode_(SgAsmX86Instruction::instructionSizeForWidth(addrWidth)), directDispatchKnown_(false),
+          directDispatch_(false), directDispatchEnabled_(true) {
         regcache_init();
         iproc_init();
         memory_init();
@@ -139,6 +150,31 @@ public:
         return insn->get_kind();
     }
 
+    /** Process one instruction.
+     *
+     *  Instructions whose processor is an X86::InsnProcessor are dispatched directly by instruction kind, without the virtual
+     *  table lookup, dynamic casts, and reference counting of the generic dispatcher. This is the common case when emulating
+     *  code with concrete semantics, where the dispatch overhead is a large part of the time spent per instruction. Other
+     *  processors are invoked by BaseSemantics::Dispatcher::processInstruction.
+     *
+     *  The direct dispatch is used only when this object is a DispatcherX86 and not a subclass, since a subclass might
+     *  override iproc_key() or iproc_lookup() and the direct dispatch would bypass them. Subclasses always go through
+     *  BaseSemantics::Dispatcher::processInstruction. */
+    virtual void processInstruction(SgAsmInstruction*) ROSE_OVERRIDE;
+
+    /** Property: whether processInstruction may dispatch directly by instruction kind.
+     *
+     *  This is enabled by default. Disabling it sends every instruction through BaseSemantics::Dispatcher::processInstruction,
+     *  which is mainly useful for measuring what the direct dispatch saves (see the "--generic-dispatch" switch of the
+     *  semanticsSpeed tests). Subclasses never dispatch directly regardless of this property.
+     *
+     * @{ */
+    bool directDispatch() const { return directDispatchEnabled_; }
+    void directDispatch(bool b) { directDispatchEnabled_ = b; }
+    /** @} */
+
+    virtual void iproc_set(int key, BaseSemantics::InsnProcessor*) ROSE_OVERRIDE;
+
     virtual void write(SgAsmExpression *e, const BaseSemantics::SValuePtr &value, size_t addr_nbits=0) ROSE_OVERRIDE;
 
     /** Architecture-specific read from register.
@@ -264,6 +300,12 @@ public:
     typedef const SgAsmExpressionPtrList &A;
     virtual void p(D, Ops, I, A) = 0;
     virtual void process(const BaseSemantics::DispatcherPtr&, SgAsmInstruction*) ROSE_OVERRIDE;
+
+    /** Process an instruction for a dispatcher.
+     *
+     *  This is how DispatcherX86::processInstruction invokes x86 instruction processors, so subclasses should change the
+     *  semantics of an instruction by overriding @ref p rather than the virtual @ref process. */
+    void process(D, Ops, I);
     virtual void assert_args(I insn, A args, size_t nargs);
     void check_arg_width(D d, I insn, A args);
 };
@@ -6,6 +6,11 @@
 
 namespace rose {
 namespace BinaryAnalysis {                      // documented elsewhere
+
+namespace ExecutionTrace {
+class Writer;
+}
+
 namespace InstructionSemantics2 {               // documented elsewhere
 
 /** A semantics domain wrapper that prints and checks all RISC operators as they occur.
@@ -39,7 +44,13 @@ namespace InstructionSemantics2 {               // documented elsewhere
  * @endcode
  *
  *  The TraceSemantics also checks for problems with operand and return value widths and reports them in the output
- *  also. Tracing can be turned off either by specifying a NULL file pointer for set_stream(), or by unwrapping the subdomain's
+ *  also.
+ *
+ *  Instead of, or in addition to, the text output, the instructions, register writes, and memory accesses can be recorded in
+ *  a compact binary execution trace by setting the @ref RiscOperators::traceWriter "traceWriter" property.  Only operations
+ *  whose addresses and values are concrete are recorded. See rose::BinaryAnalysis::ExecutionTrace.
+ *
+ *  Tracing can be turned off either by specifying a NULL file pointer for set_stream(), or by unwrapping the subdomain's
  *  RISC operators, something along these lines:
  *
  * @code
@@ -91,26 +102,27 @@ typedef boost::shared_ptr<class RiscOperators> RiscOperatorsPtr;
 class RiscOperators: public BaseSemantics::RiscOperators {
     BaseSemantics::RiscOperatorsPtr subdomain_;         // Domain to which all our RISC operators chain
     Sawyer::Message::Stream stream_;                    // stream to which output is emitted
-    
+    ExecutionTrace::Writer *traceWriter_;               // optional binary trace of instructions, registers, and memory
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors.
 protected:
     // use the version that takes a subdomain instead of this c'tor
     explicit RiscOperators(const BaseSemantics::SValuePtr &protoval, SMTSolver *solver=NULL)
-        : BaseSemantics::RiscOperators(protoval, solver), stream_(mlog[Diagnostics::INFO]) {
+        : BaseSemantics::RiscOperators(protoval, solver), stream_(mlog[Diagnostics::INFO]), traceWriter_(NULL) {
         name("Trace");
     }
 
     // use the version that takes a subdomain instead of this c'tor.
     explicit RiscOperators(const BaseSemantics::StatePtr &state, SMTSolver *solver=NULL)
-        : BaseSemantics::RiscOperators(state, solver), stream_(mlog[Diagnostics::INFO]) {
+        : BaseSemantics::RiscOperators(state, solver), stream_(mlog[Diagnostics::INFO]), traceWriter_(NULL) {
         name("Trace");
     }
 
     explicit RiscOperators(const BaseSemantics::RiscOperatorsPtr &subdomain)
         : BaseSemantics::RiscOperators(subdomain->currentState(), subdomain->solver()),
-          subdomain_(subdomain), stream_(mlog[Diagnostics::INFO]) {
+          subdomain_(subdomain), stream_(mlog[Diagnostics::INFO]), traceWriter_(NULL) {
         name("Trace");
     }
 
@@ -218,6 +230,17 @@ public:
     void stream(Sawyer::Message::Stream &s) { stream_ = s; }
     /** @} */
 
+    /** Property: Execution trace writer.
+     *
+     *  When non-null, every instruction, and every register write and memory access whose address and value are concrete,
+     *  is recorded in the binary trace in addition to any text output.  Values wider than 64 bits are not recorded.  The
+     *  writer is not owned by these operators and must outlive them or be reset to null.
+     *
+     * @{ */
+    ExecutionTrace::Writer* traceWriter() const { return traceWriter_; }
+    void traceWriter(ExecutionTrace::Writer *writer) { traceWriter_ = writer; }
+    /** @} */
+
 protected:
     void linePrefix();
     std::string toString(const BaseSemantics::SValuePtr&);
@@ -253,6 +276,7 @@ protected:
     const BaseSemantics::SValuePtr& after(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&);
     void after(const BaseSemantics::Exception&);
     void after_exception();
+    void traceMemory(bool isWrite, const BaseSemantics::SValuePtr &addr, const BaseSemantics::SValuePtr &value);
     
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Methods we override from our super class
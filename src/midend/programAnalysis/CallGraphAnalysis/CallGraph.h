@@ -32,8 +32,12 @@ namespace CallTargetSet
 {
   typedef Rose_STL_Container<SgFunctionDeclaration *> SgFunctionDeclarationPtrList;
   typedef Rose_STL_Container<SgClassDefinition *> SgClassDefinitionPtrList;
-  // returns the list of declarations of all functions that may get called via the specified pointer
-  std::vector<SgFunctionDeclaration*> solveFunctionPointerCall ( SgPointerDerefExp *, SgProject * );
+  class FunctionPointerTargetIndex;
+
+  // returns the list of declarations of all functions that may get called via the specified pointer; the possible
+  // targets are looked up in functionPointerTargets if it is non-null, otherwise the memory pool is queried
+  std::vector<SgFunctionDeclaration*> solveFunctionPointerCall ( SgPointerDerefExp *, SgProject *,
+                                                                 const FunctionPointerTargetIndex *functionPointerTargets = NULL );
 
   // returns the list of declarations of all functions that may get called via a member function pointer
   std::vector<SgFunctionDeclaration*> solveMemberFunctionPointerCall ( SgExpression *,ClassHierarchyWrapper * );
@@ -50,11 +54,13 @@ namespace CallTargetSet
   //! Let C have an explicit constructor, without explictly calling B's constructor. We will only return the constructor for C
   std::vector<SgFunctionDeclaration*> solveConstructorInitializer ( SgConstructorInitializer* sgCtorInit);
 
-  // Populates functionList with Properties of all functions that may get called.
+  // Populates functionList with Properties of all functions that may get called. Calls through function pointers are
+  // resolved with functionPointerTargets if it is non-null.
   ROSE_DLL_API void getPropertiesForExpression(SgExpression* exp,
                                                ClassHierarchyWrapper* classHierarchy,
                                                Rose_STL_Container<SgFunctionDeclaration*>& propList,
-                                               bool includePureVirtualFunc = false);
+                                               bool includePureVirtualFunc = false,
+                                               const FunctionPointerTargetIndex *functionPointerTargets = NULL);
 
   //! Populates functionList with definitions of all functions that may get called. This
   //! is basically a wrapper around getPropertiesForExpression that extracts the
@@ -82,7 +88,24 @@ namespace CallTargetSet
   SgFunctionDeclaration * getFirstVirtualFunctionDefinitionFromAncestors(SgClassType *crtClass, 
                                    SgMemberFunctionDeclaration *memberFunctionDeclaration, 
                                    ClassHierarchyWrapper *classHierarchy);
-  
+
+  //! Index of all function declarations by function type, used to resolve calls through function pointers.
+  //! Passing an index to getPropertiesForExpression() looks such calls up in it instead of querying the memory pool once
+  //! per call. The AST must not be modified during the lifetime of the index.
+  class ROSE_DLL_API FunctionPointerTargetIndex
+  {
+    public:
+      FunctionPointerTargetIndex();
+
+      //! The declarations whose type has the same mangled name as functionType, in memory pool order.
+      const std::vector<SgFunctionDeclaration*>& lookup(SgFunctionType *functionType) const;
+
+    private:
+      FunctionPointerTargetIndex(const FunctionPointerTargetIndex&);
+      FunctionPointerTargetIndex& operator=(const FunctionPointerTargetIndex&);
+
+      boost::unordered_map<std::string, std::vector<SgFunctionDeclaration*> > functionsByType;
+  };
 };
 
 class ROSE_DLL_API FunctionData
@@ -117,6 +140,62 @@ struct ROSE_DLL_API builtinFilter : public std::unary_function<bool,SgFunctionDe
   bool operator() (SgFunctionDeclaration* node) const;
 }; 
 
+//! A call graph in compressed sparse row form.
+/*! Functions are numbered densely from zero and identified by their first nondefining declaration. The callees and the
+ *  callers of a function are stored contiguously, sorted by ID and without duplicates, so they can be iterated without
+ *  allocation. */
+class ROSE_DLL_API CompactCallGraph
+{
+  public:
+    typedef unsigned int FunctionId;
+
+    static FunctionId invalidId() { return (FunctionId)(-1); }
+
+    //! A contiguous range of function IDs.
+    class Range
+    {
+        const FunctionId *begin_;
+        const FunctionId *end_;
+      public:
+        typedef const FunctionId* iterator;
+        typedef const FunctionId* const_iterator;
+
+        Range(const FunctionId *begin, const FunctionId *end): begin_(begin), end_(end) {}
+        const FunctionId* begin() const { return begin_; }
+        const FunctionId* end() const { return end_; }
+        size_t size() const { return end_ - begin_; }
+        bool empty() const { return begin_ == end_; }
+        FunctionId operator[](size_t i) const { return begin_[i]; }
+    };
+
+    size_t numberOfFunctions() const { return functions_.size(); }
+    size_t numberOfCalls() const { return callees_.size(); }
+
+    SgFunctionDeclaration* function(FunctionId id) const { return functions_[id]; }
+
+    //! ID of a function, or invalidId() if it is not in the graph.
+    FunctionId id(SgFunctionDeclaration *function) const;
+
+    Range callees(FunctionId id) const { return range(callees_, calleeOffsets_, id); }
+    Range callers(FunctionId id) const { return range(callers_, callerOffsets_, id); }
+
+    //! Replaces the graph. The i'th function gets ID i and each call is a (caller, callee) pair of IDs; calls may be
+    //! given in any order and more than once.
+    void assign(const std::vector<SgFunctionDeclaration*> &functions, std::vector<std::pair<FunctionId, FunctionId> > &calls);
+
+  private:
+    static Range range(const std::vector<FunctionId> &ids, const std::vector<FunctionId> &offsets, FunctionId id) {
+        return ids.empty() ? Range(NULL, NULL) : Range(&ids[0] + offsets[id], &ids[0] + offsets[id+1]);
+    }
+
+    std::vector<SgFunctionDeclaration*> functions_;
+    boost::unordered_map<SgFunctionDeclaration*, FunctionId> ids_;
+    std::vector<FunctionId> calleeOffsets_;                     // numberOfFunctions()+1 entries into callees_
+    std::vector<FunctionId> callees_;
+    std::vector<FunctionId> callerOffsets_;                     // numberOfFunctions()+1 entries into callers_
+    std::vector<FunctionId> callers_;
+};
+
 class ROSE_DLL_API CallGraphBuilder
 {
   public:
@@ -128,18 +207,37 @@ class ROSE_DLL_API CallGraphBuilder
       void buildCallGraph(Predicate pred);
     //! Grab the call graph built
     SgIncidenceDirectedGraph *getGraph(); 
+    //! The call graph built, in compact form. Function IDs follow the order in which graph nodes were added.
+    const CompactCallGraph& getCompactGraph() const { return compactGraph; }
     //void classifyCallGraph();
 
     //We map each function to the corresponding graph node
     boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*>& getGraphNodesMapping(){ return graphNodes; }
 
+    //! Number of threads collecting the call sites of the functions (default 1).
+    void setNumberOfThreads(size_t n) { nThreads = n; }
+
+    //! File in which the resolved callees of each function are saved, or empty (the default) for no cache.
+    /*! When set, buildCallGraph() reuses the saved callees of the functions defined in files that have not been modified
+     *  since the previous build, provided that none of the files declaring something at global or namespace scope in
+     *  the same translation unit (its headers) have been modified either, and that the set of selected functions and the
+     *  class hierarchy are unchanged. Only the functions in the other files are resolved again. The file is rewritten
+     *  after each build. */
+    void setCacheFileName(const std::string &fileName) { cacheFileName = fileName; }
+
   private:
+    //! Computes the possible callees of each function (the i'th result is for the i'th function).
+    void resolveCallees(const std::vector<SgFunctionDeclaration*> &functions,
+                        std::vector<std::vector<SgFunctionDeclaration*> > &callees);
+
     SgProject *project;
     SgIncidenceDirectedGraph *graph;
     //We map each function to the corresponding graph node
     typedef boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*> GraphNodes;
     GraphNodes graphNodes;
-
+    CompactCallGraph compactGraph;
+    size_t nThreads;
+    std::string cacheFileName;
 };
 //! Generate a dot graph named 'fileName' from a call graph 
 //TODO this function is not defined? If so, need to be removed. 
@@ -170,8 +268,8 @@ CallGraphBuilder::buildCallGraph(Predicate pred)
     // Add nodes to the graph by querying the memory pool for function declarations, mapping them to unique declarations
     // that can be used as keys in a map (using get_firstNondefiningDeclaration()), and filtering according to the predicate.
     graph = new SgIncidenceDirectedGraph();
-    std::vector<FunctionData> callGraphData;
-    ClassHierarchyWrapper classHierarchy(project);
+    std::vector<SgFunctionDeclaration*> functions;
+    std::vector<SgGraphNode*> functionNodes;
     graphNodes.clear();
     VariantVector vv(V_SgFunctionDeclaration);
     GetOneFuncDeclarationPerFunction defFunc;
@@ -180,30 +278,41 @@ CallGraphBuilder::buildCallGraph(Predicate pred)
         SgFunctionDeclaration *fdecl = isSgFunctionDeclaration(node);
         SgFunctionDeclaration *unique = isSgFunctionDeclaration(fdecl->get_firstNondefiningDeclaration());
         if (isSelected(pred)(unique) && graphNodes.find(unique)==graphNodes.end()) {
-            FunctionData fdata(unique, project, &classHierarchy); // computes functions called by unique
-            callGraphData.push_back(fdata);
             std::string functionName = unique->get_qualified_name().getString();
             SgGraphNode *graphNode = new SgGraphNode(functionName);
             graphNode->set_SgNode(unique);
             graphNodes[unique] = graphNode;
             graph->addNode(graphNode);
+            functions.push_back(unique);
+            functionNodes.push_back(graphNode);
         }
     }
 
-    // Add edges to the graph
-    BOOST_FOREACH(FunctionData &currentFunction, callGraphData) {
-        SgGraphNode *srcNode = graphNodes.find(currentFunction.functionDeclaration)->second; // we inserted it above
-        std::vector<SgFunctionDeclaration*> &callees = currentFunction.functionList;
-        BOOST_FOREACH(SgFunctionDeclaration *callee, callees) {
+    // Compute the functions called by each function
+    std::vector<std::vector<SgFunctionDeclaration*> > callees;
+    resolveCallees(functions, callees);
+
+    // Number the calls by function ID
+    boost::unordered_map<SgFunctionDeclaration*, CompactCallGraph::FunctionId> ids;
+    for (size_t i = 0; i < functions.size(); ++i)
+        ids[functions[i]] = i;
+    std::vector<std::pair<CompactCallGraph::FunctionId, CompactCallGraph::FunctionId> > calls;
+    for (size_t i = 0; i < functions.size(); ++i) {
+        BOOST_FOREACH(SgFunctionDeclaration *callee, callees[i]) {
             if (isSelected(pred)(callee)) {
-                GraphNodes::iterator dstNodeFound = graphNodes.find(callee);
-                assert(dstNodeFound!=graphNodes.end()); // should have been added above
-                SgGraphNode *dstNode = dstNodeFound->second;
-                if (graph->checkIfDirectedGraphEdgeExists(srcNode, dstNode) == false)
-                    graph->addDirectedEdge(srcNode, dstNode);
+                boost::unordered_map<SgFunctionDeclaration*, CompactCallGraph::FunctionId>::iterator dstFound = ids.find(callee);
+                assert(dstFound!=ids.end()); // should have been added above
+                calls.push_back(std::make_pair((CompactCallGraph::FunctionId)i, dstFound->second));
             }
         }
     }
+    compactGraph.assign(functions, calls);
+
+    // Add edges to the graph; the compact graph has no duplicate calls
+    for (CompactCallGraph::FunctionId src = 0; src < compactGraph.numberOfFunctions(); ++src) {
+        BOOST_FOREACH(CompactCallGraph::FunctionId dst, compactGraph.callees(src))
+            graph->addDirectedEdge(functionNodes[src], functionNodes[dst]);
+    }
 }
 
 // endif for CALL_GRAPH_H
@@ -4,6 +4,8 @@
 #include <vector>
 #include <map>
 #include <boost/unordered_set.hpp>
+#include <boost/unordered_map.hpp>
+#include <string>
 
 class ROSE_DLL_API ClassHierarchyWrapper
 {
@@ -27,6 +29,9 @@ private:
     /** Map from class to all (strict) subclasses. */
     MangledNameToClassDefsMap subclasses;
 
+    /** Mangled name of each class definition in the hierarchy, so that lookups need not recompute it. */
+    boost::unordered_map<SgClassDefinition*, std::string> mangledNames;
+
     SgIncidenceDirectedGraph* classGraph;
 
 public:
@@ -36,8 +41,16 @@ public:
     const ClassDefSet& getDirectSubclasses(SgClassDefinition *) const;
     const ClassDefSet& getAncestorClasses(SgClassDefinition *) const;
 
+    /** Map from each class to all its immediate superclasses. */
+    const MangledNameToClassDefsMap& getDirectParents() const { return directParents; }
+
 private:
 
+    /** Mangled name of the class's declaration. */
+    std::string getMangledName(SgClassDefinition *) const;
+
+    static const ClassDefSet& lookup(const MangledNameToClassDefsMap& map, const std::string& name);
+
     /** Computes the transitive closure of the child-parent class relationship.
      * @param parents map from each class to its parents. 
      * @param transitiveParents map from each class to all its ancestors */
@@ -5,7 +5,9 @@
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_traits.hpp>
+#include <Sawyer/Optional.h>
 
+#include <limits>
 #include <map>
 #include <string>
 #include <vector>
@@ -41,7 +43,19 @@ namespace EditDistance {                                // documented elsewhere
  * @endcode
  *
  *  The analysis object can be reused as many times as one likes by calling its @c compute method with different trees. The
- *  query methods always return the same results until the next call to @c compute. */
+ *  query methods always return the same results until the next call to @c compute.
+ *
+ *  When only the cost is needed and many trees are compared with one another (e.g., to find similar functions), the trees
+ *  can be prepared once and compared with a cost limit, possibly in parallel:
+ *
+ * @code
+ *  std::vector<TreeEditDistance::PreparedTree> targets;
+ *  BOOST_FOREACH (SgNode *ast, functions)
+ *      targets.push_back(TreeEditDistance::PreparedTree(ast));
+ *  TreeEditDistance::Analysis ted;
+ *  std::vector<Sawyer::Optional<double> > costs =
+ *      ted.boundedCosts(TreeEditDistance::PreparedTree(ast1), targets, 10.0, 8);
+ * @endcode */
 namespace TreeEditDistance {
 
 // Any header that #defines words that are this common is just plain stupid!
@@ -88,6 +102,41 @@ public:
     virtual bool operator()(SgNode *source, SgNode *target) = 0;
 };
 
+/** A tree prepared for comparison.
+ *
+ *  Holds the pre-order list of selected nodes of a tree together with their depths, and the number of nodes at each depth.
+ *  Preparing a tree traverses its AST once; the prepared tree can then be compared with any number of other prepared trees
+ *  by @ref Analysis::boundedCost without traversing the AST again. A prepared tree does not reflect later changes to the
+ *  AST. */
+class PreparedTree {
+    SgNode *ast_;
+    std::vector<SgNode*> nodes_;                        // selected nodes in pre-order
+    std::vector<size_t> depths_;                        // depth of each node within the tree
+    std::vector<size_t> depthCounts_;                   // number of selected nodes at each depth
+
+public:
+    /** Construct an empty tree. */
+    PreparedTree(): ast_(NULL) {}
+
+    /** Prepare a tree.
+     *
+     *  If @p file is non-null then only those nodes that belong to the specified file are selected, as for @ref
+     *  Analysis::compute. */
+    explicit PreparedTree(SgNode *ast, SgFile *file=NULL);
+
+    /** Root of the tree. */
+    SgNode* ast() const { return ast_; }
+
+    /** Selected nodes in pre-order. */
+    const std::vector<SgNode*>& nodes() const { return nodes_; }
+
+    /** Depth of each selected node. */
+    const std::vector<size_t>& depths() const { return depths_; }
+
+    /** Number of selected nodes at each depth. */
+    const std::vector<size_t>& depthCounts() const { return depthCounts_; }
+};
+
 /** Analysis object for tree edit distance.
  *
  *  The Analysis object holds the settings and state for performing tree edit distance. See @ref TreeEditDistance for details
@@ -234,6 +283,32 @@ public:
     Analysis& compute();
     /** @} */
 
+    /** Cost for making one tree the same shape as another, with an upper limit.
+     *
+     *  Returns the same value as @ref cost would return after calling @ref compute with the same two trees and settings, or
+     *  nothing if that cost is greater than @p maxCost.  The cost is computed directly over the edit matrix one row at a time
+     *  in \f$O(V_t)\f$ memory without building a graph, and the computation stops as soon as every partial edit path
+     *  exceeds @p maxCost.  Pairs whose @ref lowerBound exceeds @p maxCost are rejected without examining the matrix. This
+     *  method does not change the results stored in this analysis. */
+    Sawyer::Optional<double> boundedCost(const PreparedTree &source, const PreparedTree &target,
+                                         double maxCost = std::numeric_limits<double>::infinity()) const;
+
+    /** Lower bound for the edit cost.
+     *
+     *  Substitution is only possible between nodes at the same depth, so every node at depth @em d beyond the number of
+     *  nodes at depth @em d in the other tree must be inserted or deleted. The sum of those costs is a lower bound for the
+     *  edit cost that can be computed in time proportional to the depth of the trees. */
+    double lowerBound(const PreparedTree &source, const PreparedTree &target) const;
+
+    /** Compare one tree with many.
+     *
+     *  Returns @ref boundedCost for @p source and each of the @p targets, in the same order.  The comparisons are divided
+     *  among @p nThreads threads (zero means use the hardware concurrency), so the @ref substitutionPredicate, if any,
+     *  must be safe to call concurrently. */
+    std::vector<Sawyer::Optional<double> >
+    boundedCosts(const PreparedTree &source, const std::vector<PreparedTree> &targets,
+                 double maxCost = std::numeric_limits<double>::infinity(), size_t nThreads = 1) const;
+
     /** Total cost for making one tree the same shape as the other.
      *
      *  This is the same value returned by the previous call to @ref compute and also available by querying for the actual list
@@ -11,6 +11,8 @@
 #include "GlobalVarAnalysis.h"
 #include <boost/config.hpp>
 #include <boost/bind.hpp>
+#include <algorithm>
+#include <iterator>
 
 
 using namespace std;
@@ -81,6 +83,18 @@ void DefUseAnalysis::addUseElement(SgNode* sgNode,
   addAnyElement(&usetable, sgNode, initName, defNode);
 }
 
+/**********************************************************
+ *  Return the dense ID of an (initName, node) entry,
+ *  numbering it if it is new
+ *********************************************************/
+unsigned DefUseAnalysis::getEntryId(SgInitializedName* initName, SgNode* node) {
+  std::pair<rose_hash::unordered_map< std::pair<SgInitializedName*, SgNode*>, unsigned >::iterator, bool> inserted =
+    entryIds.insert(make_pair(make_pair(initName, node), (unsigned)entries.size()));
+  if (inserted.second)
+    entries.push_back(make_pair(initName, node));
+  return inserted.first->second;
+}
+
 /**********************************************************
  *  Add an element to the table
  *********************************************************/
@@ -90,15 +104,26 @@ void DefUseAnalysis::addAnyElement(tabletype* tabl, SgNode* sgNode,
 #if ROSE_GCC_OMP
 #pragma omp critical (DefUseAnalysisaddUseE) 
 #endif
-  //  (*tabl)[sgNode].insert(make_pair(initName, defNode));
-  (*tabl)[sgNode].push_back(make_pair(initName, defNode));
+  {
+    unsigned id = getEntryId(initName, defNode);
+    idset& ids = (*tabl)[sgNode];
+    idset::iterator pos = std::lower_bound(ids.begin(), ids.end(), id);
+    if (pos == ids.end() || *pos != id)
+      ids.insert(pos, id);
+  }
    addID(sgNode);
 }
 
-bool DefUseAnalysismycond(std::pair<SgInitializedName*,SgNode* > n1, SgInitializedName* init) {
-  if (n1.first==init)
-    return true;
-  return false;
+/**********************************************************
+ *  Remove all entries of initName from a set of entries
+ *********************************************************/
+void DefUseAnalysis::removeAnyElements(idset& ids, SgInitializedName* initName) {
+  idset::iterator out = ids.begin();
+  for (idset::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+    if (entries[*i].first != initName)
+      *out++ = *i;
+  }
+  ids.erase(out, ids.end());
 }
 
 /**********************************************************
@@ -117,11 +142,10 @@ void DefUseAnalysis::replaceElement(SgNode* sgNode,
     //table[sgNode].erase(initName);
     //    table[sgNode].insert(make_pair(initName,sgNode));
 
-    multitype& map = table[sgNode];
-    map.erase(std::remove_if(map.begin(), map.end(), boost::bind(boost::type<bool>(), DefUseAnalysismycond, _1, initName)), map.end());
-    //         table[sgNode].erase(it);
-
-    table[sgNode].push_back(make_pair(initName,sgNode));
+    idset& ids = table[sgNode];
+    removeAnyElements(ids, initName);
+    unsigned id = getEntryId(initName, sgNode);
+    ids.insert(std::lower_bound(ids.begin(), ids.end(), id), id);
   }
 }
 
@@ -136,8 +160,7 @@ void DefUseAnalysis::clearUseOfElement(SgNode* sgNode,
   {
   //  usetable[sgNode].erase(initName);
 
-    multitype& map = usetable[sgNode];
-    map.erase(std::remove_if(map.begin(), map.end(), boost::bind(boost::type<bool>(), DefUseAnalysismycond, _1, initName)), map.end());
+    removeAnyElements(usetable[sgNode], initName);
 
   }
 }
@@ -182,16 +205,13 @@ void DefUseAnalysis::mapAnyUnion(tabletype* tabl, SgNode* before, SgNode* other,
     if (!otherFound) 
       (*tabl)[sgNode]=(*tabl)[before];
     else {
-
-      const multitype& multiA  = (*tabl)[before];
-      const multitype& multiB  = (*tabl)[other];
-      std::set<std::pair<SgInitializedName*, SgNode*> > s_before(multiA.begin(), multiA.end());
-       ROSE_ASSERT (s_before.size() == (*tabl)[before].size());
-
-      s_before.insert(multiB.begin(), multiB.end());
-      multitype multiC(s_before.begin(), s_before.end());
-      (*tabl)[sgNode].swap(multiC);
-      
+      // both sets are sorted; sgNode may be before or other, so merge into a new set
+      const idset& idsA = (*tabl)[before];
+      const idset& idsB = (*tabl)[other];
+      idset idsC;
+      idsC.reserve(std::max(idsA.size(), idsB.size()));
+      std::set_union(idsA.begin(), idsA.end(), idsB.begin(), idsB.end(), std::back_inserter(idsC));
+      (*tabl)[sgNode].swap(idsC);
     }
   }
 }
@@ -267,7 +287,7 @@ void DefUseAnalysis::printAnyMap(tabletype* tabl) {
     pos++;
     SgNode* sgNode = (*i).first;
     ROSE_ASSERT(sgNode);
-    multitype multi = (*i).second;
+    multitype multi = getAnyMultiMapFor(tabl, sgNode);
     string name = getInitName(sgNode);
     int theNode = getIntForSgNode(sgNode);
     cout << pos << ": " << ToString(theNode) << " var: " << name << endl;
@@ -358,8 +378,7 @@ bool DefUseAnalysis::searchMap(const tabletype* ltable, SgNode* node) {
  * for any given node and initName, return all definitions 
  *****************************************/
 std::vector < SgNode* > DefUseAnalysis::getDefFor(SgNode* node, SgInitializedName* initName) {
-  multitype multi = getDefMultiMapFor(node);
-  return getAnyFor( &multi, initName); 
+  return getAnyFor(&table, node, initName); 
 }
 
 /******************************************
@@ -367,8 +386,24 @@ std::vector < SgNode* > DefUseAnalysis::getDefFor(SgNode* node, SgInitializedNam
  * for any given node and initName, return all definitions 
  *****************************************/
 std::vector < SgNode* > DefUseAnalysis::getUseFor(SgNode* node, SgInitializedName* initName) {
-  multitype multi = getUseMultiMapFor(node);
-  return getAnyFor(&multi, initName); 
+  return getAnyFor(&usetable, node, initName); 
+}
+
+/******************************************
+ * for any given node and initName, return all nodes
+ * of the table entry of node, without copying the entry
+ *****************************************/
+std::vector < SgNode* > DefUseAnalysis::getAnyFor(const tabletype* tabl, SgNode* node, SgInitializedName* initName) {
+  vector < SgNode*> defNodes;
+  tabletype::const_iterator found = tabl->find(node);
+  if (found != tabl->end()) {
+    const idset& ids = found->second;
+    for (idset::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+      if (entries[*i].first == initName)
+        defNodes.push_back(entries[*i].second);
+    }
+  }
+  return defNodes;
 }
 
 /******************************************
@@ -398,12 +433,7 @@ std::vector < SgNode* > DefUseAnalysis::getAnyFor(const multitype* multi, SgInit
  * for any given node, return all definitions 
  *****************************************/
 std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getDefMultiMapFor(SgNode* node) {
-  multitype multi;
-  if (searchMap(&table, node)==true) {
-    // multimap is contained
-    multi = table[node];
-  }
-  return multi;
+  return getAnyMultiMapFor(&table, node);
 }
 
 /******************************************
@@ -411,14 +441,87 @@ std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getDefM
  * for any given node, return all definitions 
  *****************************************/
 std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getUseMultiMapFor(SgNode* node) {
+  return getAnyMultiMapFor(&usetable, node);
+}
+
+/******************************************
+ * return multimap to user
+ * for any given node, return all entries
+ *****************************************/
+std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getAnyMultiMapFor(const tabletype* tabl, SgNode* node) {
   multitype multi;
-  if (searchMap(&usetable, node)==true) {
+  tabletype::const_iterator found = tabl->find(node);
+  if (found != tabl->end()) {
     // multimap is contained
-    multi = usetable[node];
+    multi.reserve(found->second.size());
+    for (idset::const_iterator i = found->second.begin(); i != found->second.end(); ++i)
+      multi.push_back(entries[*i]);
   }
   return multi;
 }
 
+/******************************************
+ * return the entry IDs of a node, without copying
+ *****************************************/
+const DefUseAnalysis::idset& DefUseAnalysis::getDefIdsFor(SgNode* node) const {
+  static const idset empty;
+  tabletype::const_iterator found = table.find(node);
+  return found == table.end() ? empty : found->second;
+}
+
+/******************************************
+ * return the entry IDs of a node, without copying
+ *****************************************/
+const DefUseAnalysis::idset& DefUseAnalysis::getUseIdsFor(SgNode* node) const {
+  static const idset empty;
+  tabletype::const_iterator found = usetable.find(node);
+  return found == usetable.end() ? empty : found->second;
+}
+
+/******************************************
+ * is the entry (initName, node) in the set
+ *****************************************/
+bool DefUseAnalysis::containsEntry(const idset& ids, SgInitializedName* initName, SgNode* node) const {
+  rose_hash::unordered_map< std::pair<SgInitializedName*, SgNode*>, unsigned >::const_iterator id =
+    entryIds.find(make_pair(initName, node));
+  return id != entryIds.end() && std::binary_search(ids.begin(), ids.end(), id->second);
+}
+
+/******************************************
+ * is any entry of initName in the set
+ *****************************************/
+bool DefUseAnalysis::containsInitName(const idset& ids, SgInitializedName* initName) const {
+  for (idset::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+    if (entries[*i].first == initName)
+      return true;
+  }
+  return false;
+}
+
+/******************************************
+ * return the whole table as multimaps
+ *****************************************/
+std::map< SgNode* , DefUseAnalysis::multitype > DefUseAnalysis::getAnyMap(const tabletype* tabl) {
+  std::map< SgNode* , multitype > map;
+  for (tabletype::const_iterator i = tabl->begin(); i != tabl->end(); ++i)
+    map[i->first] = getAnyMultiMapFor(tabl, i->first);
+  return map;
+}
+
+/******************************************
+ * replace the whole table by the given multimaps
+ *****************************************/
+void DefUseAnalysis::setAnyMap(tabletype* tabl, const std::map< SgNode* , multitype >& map) {
+  tabl->clear();
+  for (std::map< SgNode* , multitype >::const_iterator i = map.begin(); i != map.end(); ++i) {
+    idset& ids = (*tabl)[i->first];
+    for (multitype::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
+      ids.push_back(getEntryId(j->first, j->second));
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  }
+}
+
 /******************************************
  * return all global variables
  *****************************************/
@@ -69,7 +69,13 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   typedef std::vector < std::pair<SgInitializedName* , SgNode*> > multitype;
   //  typedef std::multimap < SgInitializedName* , SgNode* > multitype;
 
-  typedef std::map< SgNode* , multitype > tabletype;
+ public:
+  // The tables store, for each node, the sorted IDs of its (initName, node) entries.
+  // IDs are dense and shared by the def and use tables; see getEntry().
+  typedef std::vector<unsigned> idset;
+
+ private:
+  typedef rose_hash::unordered_map< SgNode* , idset > tabletype;
   // typedef std::map< SgNode* , int > convtype;
 // CH (4/9/2010): Use boost::unordered instead  
 //#ifdef _MSC_VER
@@ -90,6 +96,9 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   // the main table of all entries
   tabletype table;
   tabletype usetable;
+  // the (initName, node) pair of each entry ID, and its inverse
+  multitype entries;
+  rose_hash::unordered_map< std::pair<SgInitializedName*, SgNode*>, unsigned > entryIds;
   // table for indirect definitions
   //ideftype idefTable;
   // the helper table for visualization
@@ -103,6 +112,12 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   void addAnyElement(tabletype* tabl, SgNode* sgNode, SgInitializedName* initName, SgNode* defNode);
   void mapAnyUnion(tabletype* tabl, SgNode* before, SgNode* other, SgNode* current);
   void printAnyMap(tabletype* tabl);
+  void removeAnyElements(idset& ids, SgInitializedName* initName);
+  unsigned getEntryId(SgInitializedName* initName, SgNode* node);
+  multitype getAnyMultiMapFor(const tabletype* tabl, SgNode* node);
+  std::map< SgNode* , multitype > getAnyMap(const tabletype* tabl);
+  void setAnyMap(tabletype* tabl, const std::map< SgNode* , multitype >& map);
+  std::vector < SgNode* > getAnyFor(const tabletype* tabl, SgNode* node, SgInitializedName* initName);
 
 
  public:
@@ -117,13 +132,26 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   };
   virtual ~DefUseAnalysis() {}
 
-  std::map< SgNode* , multitype  > getDefMap() { return table;}
-  std::map< SgNode* , multitype  > getUseMap() { return usetable;}
+  std::map< SgNode* , multitype  > getDefMap() { return getAnyMap(&table);}
+  std::map< SgNode* , multitype  > getUseMap() { return getAnyMap(&usetable);}
   void setMaps(std::map< SgNode* , multitype  > def,
           std::map< SgNode* , multitype > use) {
-    table = def;
-    usetable = use;
+    setAnyMap(&table, def);
+    setAnyMap(&usetable, use);
+  }
+
+  // def-use tables without copying ------
+  // The entry IDs of a node (empty if the node is not in the table). The
+  // reference is valid until the table is modified.
+  const idset& getDefIdsFor(SgNode* node) const;
+  const idset& getUseIdsFor(SgNode* node) const;
+  // The (initName, node) pair of an entry ID
+  const std::pair<SgInitializedName*, SgNode*>& getEntry(unsigned id) const {
+    return entries[id];
   }
+  // whether ids contains the entry (initName, node), resp. any entry of initName
+  bool containsEntry(const idset& ids, SgInitializedName* initName, SgNode* node) const;
+  bool containsInitName(const idset& ids, SgInitializedName* initName) const;
        
   // def-use-public-functions -----------
   int run();
@@ -163,6 +191,8 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   void flush() {
    table.clear();
    usetable.clear();
+   entries.clear();
+   entryIds.clear();
    globalVarList.clear();
    vizzhelp.clear();
    sgNodeCounter=1;
@@ -30,6 +30,7 @@ class DefUseAnalysisAbstract : public Support {
   //  typedef std::multimap < SgInitializedName* , SgNode* > multitype;
   typedef std::vector < std::pair < SgInitializedName* , SgNode* > > multitype;
   typedef std::map< SgNode* , multitype > tabletype;
+  typedef DefUseAnalysis::idset idset;
   typedef FilteredCFGEdge < IsDFAFilter > filteredCFGEdgeType;
   typedef FilteredCFGNode < IsDFAFilter > filteredCFGNodeType;
 
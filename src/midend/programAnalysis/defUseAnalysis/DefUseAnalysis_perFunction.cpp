@@ -15,9 +15,7 @@ using namespace std;
  *********************************************************/
 bool DefUseAnalysisPF::makeSureThatTheDefIsInTable(SgInitializedName* initName) {
   bool addedNode = false;
-  vector<pair<SgInitializedName*, SgNode*> > mymap = dfa->getDefMultiMapFor(
-                                                                            initName);
-  if (mymap.size() == 0) {
+  if (dfa->getDefIdsFor(initName).empty()) {
     dfa->addDefElement(initName, initName, initName);
     addedNode = true;
     if (DEBUG_MODE)
@@ -36,9 +34,7 @@ bool DefUseAnalysisPF::makeSureThatTheDefIsInTable(SgInitializedName* initName)
  *********************************************************/
 bool DefUseAnalysisPF::makeSureThatTheUseIsInTable(SgInitializedName* initName) {
   bool addedNode = false;
-  vector<pair<SgInitializedName*, SgNode*> > mymap = dfa->getUseMultiMapFor(
-                                                                            initName);
-  if (mymap.size() == 0) {
+  if (dfa->getUseIdsFor(initName).empty()) {
     dfa->addUseElement(initName, initName, initName);
     addedNode = true;
     if (DEBUG_MODE)
@@ -555,11 +551,10 @@ bool DefUseAnalysisPF::performUseAndDefinition(SgNode* sgNode,
   if (DEBUG_MODE)
     cout << "  ----- IS USE. " << sgNode << " : " << sgNode->class_name()
          << " : " << initName->get_qualified_name().str() << endl;
-  multitype oldTable = dfa->getDefMultiMapFor(sgNode);
+  idset oldTable = dfa->getDefIdsFor(sgNode);
   handleDefCopy(sgNode, cfgNode.inEdges().size(), sgNodeBefore, cfgNode);
-  multitype newTable = dfa->getDefMultiMapFor(sgNode);
   // did the copying change anything ?
-  changedTableEntry = checkElementsForEquality(&oldTable, &newTable);
+  changedTableEntry = oldTable != dfa->getDefIdsFor(sgNode);
 
   if (DEBUG_MODE)
     cout << "  ----- IS USE. CHANGED TABLE ? "
@@ -568,8 +563,7 @@ bool DefUseAnalysisPF::performUseAndDefinition(SgNode* sgNode,
 
   if (isUsage) {
     // tracking the use table
-    multitype mmUse = dfa->getUseMultiMapFor(sgNode);
-    if (isDoubleExactEntry(&mmUse, initName, sgNode) == false)
+    if (dfa->containsEntry(dfa->getUseIdsFor(sgNode), initName, sgNode) == false)
       dfa->addUseElement(sgNode, initName, sgNode);
   }
 
@@ -579,8 +573,7 @@ bool DefUseAnalysisPF::performUseAndDefinition(SgNode* sgNode,
            << "  initName: " << initName->get_qualified_name().str()
            << endl;
     // check if global var is contained in this multimap, if not, we nned to add it
-    multitype mmap = dfa->getDefMultiMapFor(sgNode);
-    bool isGlobalContainedinMM = searchMulti(&mmap, initName);
+    bool isGlobalContainedinMM = dfa->containsInitName(dfa->getDefIdsFor(sgNode), initName);
     bool isGlobalContainedinM = dfa->searchMap(initName);
     if (DEBUG_MODE) {
       cout << " globalVariable is containd in MultiMap ? " << resBool(
@@ -623,8 +616,7 @@ bool DefUseAnalysisPF::performUseAndDefinition(SgNode* sgNode,
     // and add conservatively all possible values
     if (isDefinition) {
       // the global variable is being overwritten
-      multitype mm = dfa->getDefMultiMapFor(initName);
-      if (isDoubleExactEntry(&mm, initName, sgNode) == false)
+      if (dfa->containsEntry(dfa->getDefIdsFor(initName), initName, sgNode) == false)
         dfa->addDefElement(initName, initName, sgNode);
     }
   }
@@ -633,12 +625,8 @@ bool DefUseAnalysisPF::performUseAndDefinition(SgNode* sgNode,
     handleUseCopy(sgNode, cfgNode.inEdges().size(), sgNodeBefore, cfgNode);
     dfa->clearUseOfElement(sgNode, initName);
 
-    bool isCurrentValueContained = false;
-    multitype mul = dfa->getDefMultiMapFor(initName);
     //multitype mul = dfa->getDefUseFor(sgNode);
-    if (mul.size() > 0) {
-      isCurrentValueContained = searchMulti(&mul, initName);
-    }
+    bool isCurrentValueContained = dfa->containsInitName(dfa->getDefIdsFor(initName), initName);
     /*
     // DEBUG HELP
     if (isSgFunctionCallExp(sgNode)) {
@@ -698,7 +686,7 @@ bool DefUseAnalysisPF::performUseAndDefinition(SgNode* sgNode,
       // if it is the same as current. If yes, done.
       // Otherwise update the multimap with the union.
       if (nrOfInEdges <= 1) {
-        multitype oldTable = dfa->getDefMultiMapFor(sgNode);
+        idset oldTable = dfa->getDefIdsFor(sgNode);
         /* / --
            cout << " !!!!!!!!!!!!!! oldTable " << dfa->getIntForSgNode(sgNode) << endl;
            dfa->printMultiMap(&oldTable);
@@ -718,19 +706,17 @@ bool DefUseAnalysisPF::performUseAndDefinition(SgNode* sgNode,
           if (isDoubleExactEntry(&mul, initName, sgNode)==false) {
           dfa->addElement(sgNode, initName, sgNode);
         */
-        multitype mm = dfa->getDefMultiMapFor(sgNode);
         if (dont_replace == true) {
-          if (isDoubleExactEntry(&mm, initName, sgNode) == false)
+          if (dfa->containsEntry(dfa->getDefIdsFor(sgNode), initName, sgNode) == false)
             dfa->addDefElement(sgNode, initName, sgNode);
         } else
           dfa->replaceElement(sgNode, initName);
-        mm = dfa->getDefMultiMapFor(sgNode);
         /*/ ---
           cout << " !!!!!!!!!!!!!! newTable " << dfa->getIntForSgNode(sgNode) << endl;
           multitype mm2 = dfa->getDefUseFor(sgNode);
           dfa->printMultiMap(&mm2);
           // -- */
-        changedTableEntry = checkElementsForEquality(&oldTable, &(mm));
+        changedTableEntry = oldTable != dfa->getDefIdsFor(sgNode);
         if (DEBUG_MODE)
           cout << "  ----- changed table (one incoming)  "
                << resBool(changedTableEntry) << "  dont_replace: "
@@ -745,11 +731,11 @@ bool DefUseAnalysisPF::performUseAndDefinition(SgNode* sgNode,
         // otherwise, it we have more than one in-edge, we union the maps
         SgNode* otherInNode = getOtherInNode(cfgNode, sgNodeBefore);
         ROSE_ASSERT(otherInNode);
-        multitype oldTable = dfa->getDefMultiMapFor(sgNode);
+        idset oldTable = dfa->getDefIdsFor(sgNode);
         dfa->mapDefUnion(sgNodeBefore, otherInNode, sgNode);
         // if the value contained is the same, replace it
         // otherwise add it
-        if (isDoubleExactEntry(&oldTable, initName, sgNode) == false) {
+        if (dfa->containsEntry(oldTable, initName, sgNode) == false) {
           // important case: if the decision node (2 inedges) is
           // changing the value as well, handle special
           dfa->replaceElement(sgNode, initName);
@@ -760,9 +746,7 @@ bool DefUseAnalysisPF::performUseAndDefinition(SgNode* sgNode,
         } else {
           dfa->replaceElement(sgNode, initName);
           //cout << ">>> replaceElement" << endl;
-          multitype mm = dfa->getDefMultiMapFor(sgNode);
-          changedTableEntry = checkElementsForEquality(&oldTable,
-                                                       &(mm));
+          changedTableEntry = oldTable != dfa->getDefIdsFor(sgNode);
         }
 
         if (DEBUG_MODE)
@@ -792,7 +776,6 @@ void DefUseAnalysisPF::handleDefCopy(SgNode* sgNode, int nrOfInEdges,
   if (nrOfInEdges <= 1) {
     if (DEBUG_MODE)
       cout << " ---- DEFCOPY: 1 EDGE " << sgNode << endl;
-    multitype oldTable = dfa->getDefMultiMapFor(sgNode);
     dfa->mapDefUnion(sgNodeBefore, NULL, sgNode);
     //  replaceElement(sgNode, initName);
   } else {
@@ -801,7 +784,6 @@ void DefUseAnalysisPF::handleDefCopy(SgNode* sgNode, int nrOfInEdges,
     // otherwise, it we have more than one in-edge, we union the maps
     SgNode* otherInNode = getOtherInNode(cfgNode, sgNodeBefore);
     ROSE_ASSERT(otherInNode);
-    multitype oldTable = dfa->getDefMultiMapFor(sgNode);
     dfa->mapDefUnion(sgNodeBefore, otherInNode, sgNode);
     //replaceElement(sgNode, initName);
   }
@@ -825,7 +807,6 @@ void DefUseAnalysisPF::handleUseCopy(SgNode* sgNode, int nrOfInEdges,
   if (nrOfInEdges <= 1) {
     if (DEBUG_MODE)
       cout << " ---- USECOPY: 1 EDGE " << sgNode << endl;
-    multitype oldTable = dfa->getUseMultiMapFor(sgNode);
     dfa->mapUseUnion(sgNodeBefore, NULL, sgNode);
     //  replaceElement(sgNode, initName);
   } else {
@@ -834,7 +815,6 @@ void DefUseAnalysisPF::handleUseCopy(SgNode* sgNode, int nrOfInEdges,
     // otherwise, it we have more than one in-edge, we union the maps
     SgNode* otherInNode = getOtherInNode(cfgNode, sgNodeBefore);
     ROSE_ASSERT(otherInNode);
-    multitype oldTable = dfa->getUseMultiMapFor(sgNode);
     dfa->mapUseUnion(sgNodeBefore, otherInNode, sgNode);
     //replaceElement(sgNode, initName);
   }
@@ -270,26 +270,17 @@ bool LivenessAnalysis::defuse(T cfgNode, bool *unhandled) {
         SgVarRefExp* varRef = isSgVarRefExp(sgNode);
         bool defNode = false;
         bool useNode = false;
+        // look the entries up in place instead of copying them out of the tables
         if (initName) {
-                std::vector<SgNode*> defs = dfa->getDefFor(sgNode, initName);
                 //get the def and use for the current node
-                std::vector<SgNode*>::const_iterator it = defs.begin();
-                for (; it != defs.end(); ++it) {
-                        SgNode* itNode = *it;
-                        if (itNode == sgNode)
-                                defNode = true;
-                }
+                if (dfa->containsEntry(dfa->getDefIdsFor(sgNode), initName, sgNode))
+                        defNode = true;
         }
         if (varRef) {
                 initName = varRef->get_symbol()->get_declaration();
                 ROSE_ASSERT(initName);
-                std::vector<SgNode*> uses = dfa->getUseFor(sgNode, initName);
-                std::vector<SgNode*>::const_iterator it = uses.begin();
-                for (; it != uses.end(); ++it) {
-                        SgNode* itNode = *it;
-                        if (itNode == sgNode)
-                                useNode = true;
-                }
+                if (dfa->containsEntry(dfa->getUseIdsFor(sgNode), initName, sgNode))
+                        useNode = true;
         }
 #if 0
         SgPntrArrRefExp* varRefArr = isSgPntrArrRefExp(sgNode);
@@ -375,21 +366,16 @@ bool LivenessAnalysis::defuse(T cfgNode, bool *unhandled) {
                 // go through all initialized names for out
                 // and cancel the InitializedName for in if it is
                 // defined for this node
-                std::vector<SgInitializedName*> vec = out[sgNode];
-                for (std::vector<SgInitializedName*>::iterator inIt = vec.begin(); inIt
+                const std::vector<SgInitializedName*>& vec = out[sgNode];
+                const DefUseAnalysis::idset& defIds = dfa->getDefIdsFor(sgNode);
+                for (std::vector<SgInitializedName*>::const_iterator inIt = vec.begin(); inIt
                                 != vec.end(); ++inIt) {
                         SgInitializedName* initN = isSgInitializedName(*inIt);
-                        std::vector<SgNode*> defs = dfa->getDefFor(sgNode, initN);
-                        std::vector<SgNode*>::const_iterator it = defs.begin();
-                        for (; it != defs.end(); ++it) {
-                                SgNode* itNode = *it;
-                                if (itNode == sgNode) {
-                                        // We mark the current node (SgNode) as being defined here
-                                        // its defined with the variable initName
-                                        defNode = true;
-                                        initName = initN;
-                                        break;
-                                }
+                        if (dfa->containsEntry(defIds, initN, sgNode)) {
+                                // We mark the current node (SgNode) as being defined here
+                                // its defined with the variable initName
+                                defNode = true;
+                                initName = initN;
                         }
                 }
                 if (DEBUG_MODE) {
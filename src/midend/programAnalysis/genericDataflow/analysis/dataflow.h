@@ -6,12 +6,15 @@
 #include "functionState.h"
 #include "analysis.h"
 #include "lattice.h"
+#include "compactCFG.h"
 
 #include <boost/shared_ptr.hpp>
 #include <vector>
 #include <set>
 #include <map>
+#include <list>
 #include <string>
+#include <ostream>
 
 // !!! NOTE: THE CURRENT INTER-/INTRA-PROCEDURAL ANALYSIS API EFFECTIVELY ASSUMES THAT EACH ANALYSIS WILL BE EXECUTED
 // !!!       ONCE BECAUSE DURING A GIVEN ANALYSIS PASS THE INTRA- ANALYSIS MAY ACCUMULATE STATE AND THERE IS NO
@@ -207,13 +210,66 @@ class FindAllFunctionCalls : public UnstructuredPassIntraAnalysis
 class IntraUniDirectionalDataflow : public IntraUnitDataflow
 {
         public:
+        // The order in which runAnalysis() processes the nodes on its worklist
+        enum WorklistOrder
+        {
+                // first-in first-out, visiting the nodes downstream of the initial worklist breadth-first
+                // (VirtualCFG::dataflow)
+                ITERATOR_ORDER,
+                // the pending node that comes first in reverse postorder of the analysis direction, so that
+                // a loop body stabilizes before the nodes after the loop are visited
+                REVERSE_POSTORDER
+        };
+
+        // Work done by runAnalysis() on one function, accumulated over all the times it was analyzed
+        struct Statistics
+        {
+                // number of times runAnalysis() was called on the function
+                size_t runs;
+                // number of nodes taken off the worklist
+                size_t nodeVisits;
+                // number of transfer function applications (including those of function calls)
+                size_t transfers;
+                // number of Lattice meet (or meet and widen) operations done while propagating to descendants
+                size_t meets;
+
+                Statistics() : runs(0), nodeVisits(0), transfers(0), meets(0) {}
+        };
+
+        // The function's CFG as materialized for the REVERSE_POSTORDER worklist, built in the analysis direction
+        typedef VirtualCFG::CompactCFG<DataflowNode, DataflowEdge> CompactCFG;
+
+        IntraUniDirectionalDataflow() : worklistOrder(ITERATOR_ORDER), currentStatistics(NULL) {}
 
         // Runs the intra-procedural analysis on the given function and returns true if
         // the function's NodeState gets modified as a result and false otherwise
         // state - the function's NodeState
         bool runAnalysis(const Function& func, NodeState* state, bool analyzeDueToCallers, std::set<Function> calleesUpdated);
 
+        void setWorklistOrder(WorklistOrder order) { worklistOrder = order; }
+        WorklistOrder getWorklistOrder() const { return worklistOrder; }
+
+        // Returns the statistics of the given function (all zero if it has not been analyzed)
+        Statistics getStatistics(const Function& func) const;
+
+        // Returns the statistics of all the analyzed functions
+        const std::map<Function, Statistics>& getAllStatistics() const { return statistics; }
+
+        void clearStatistics() { statistics.clear(); }
+
+        // Prints one line of statistics per analyzed function, followed by the totals
+        void printStatistics(std::ostream& out) const;
+
         protected:
+        WorklistOrder worklistOrder;
+        std::map<Function, Statistics> statistics;
+        // statistics of the function currently being analyzed, or NULL
+        Statistics* currentStatistics;
+
+        // Builds the graph of the nodes reachable from roots in the analysis direction, so that the successors of a
+        // vertex are the descendants of its node (see getDescendants())
+        void buildCompactCFG(const std::list<DataflowNode>& roots, CompactCFG& cfg);
+
         // propagates the dataflow info from the current node's NodeState (curNodeState) to the next node's
         // NodeState (nextNodeState)
         bool propagateStateToNextNode(
@@ -236,6 +292,8 @@ class IntraUniDirectionalDataflow : public IntraUnitDataflow
 
         virtual vector<DataflowNode> getDescendants(const DataflowNode &n) = 0;
         virtual DataflowNode getUltimate(const Function &func) = 0;
+        // The direction of the CFG edges that lead from a node to its descendants
+        virtual CompactCFG::Direction getDirection() const = 0;
 };
 
 /* Forward Intra-Procedural Dataflow Analysis */
@@ -254,6 +312,7 @@ class IntraFWDataflow  : public IntraUniDirectionalDataflow
         void transferFunctionCall(const Function &func, const DataflowNode &n, NodeState *state);
         vector<DataflowNode> getDescendants(const DataflowNode &n);
         DataflowNode getUltimate(const Function &func);
+        CompactCFG::Direction getDirection() const { return CompactCFG::FORWARD; }
 };
 
 /* Backward Intra-Procedural Dataflow Analysis */
@@ -272,6 +331,7 @@ class IntraBWDataflow  : public IntraUniDirectionalDataflow
         void transferFunctionCall(const Function &func, const DataflowNode &n, NodeState *state);
         vector<DataflowNode> getDescendants(const DataflowNode &n);
         DataflowNode getUltimate(const Function &func);
+        CompactCFG::Direction getDirection() const { return CompactCFG::BACKWARD; }
 };
 
 /*// Dataflow class that maintains a Lattice for every currently live variable
@@ -5,8 +5,11 @@
 #include "variables.h"
 #include <string>
 #include <map>
+#include <Sawyer/SmallObject.h>
 
-class Lattice : public printable
+// Lattices are small and are created and copied at every CFG node by every analysis, so they are
+// allocated from Sawyer's pool allocator rather than the global heap.
+class Lattice : public printable, public Sawyer::SmallObject
 {
         public:
         // initializes this Lattice to its default state, if it is not already initialized
@@ -11,6 +11,9 @@ class NodeState;
 #include <vector>
 #include <string>
 #include <set>
+#include <deque>
+#include <functional>
+#include <boost/unordered_map.hpp>
 
 #ifdef THREADED
 #include "tbb/concurrent_hash_map.h"
@@ -86,6 +89,90 @@ class NodeStateHashCompare
 };
 #endif
 
+// A map from analyses to values. It provides the subset of the std::map interface that NodeState uses.
+// A node is only visited by a few analyses, so the entries are found by binary search in a small
+// vector of slot numbers sorted by analysis. The values are kept in a deque, so references to them
+// remain valid when analyses are added.
+template<class T, class AnalysisT = Analysis>
+class AnalysisMap
+{
+        public:
+        typedef std::pair<AnalysisT*, T> value_type;
+        typedef value_type* iterator;
+        typedef const value_type* const_iterator;
+        
+        AnalysisMap() {}
+        
+        iterator find(const AnalysisT* analysis)
+        {
+                size_t i = lowerBound(analysis);
+                return (i < index.size() && slots[index[i]].first == analysis) ? &slots[index[i]] : end();
+        }
+        
+        const_iterator find(const AnalysisT* analysis) const
+        {
+                size_t i = lowerBound(analysis);
+                return (i < index.size() && slots[index[i]].first == analysis) ? &slots[index[i]] : end();
+        }
+        
+        iterator end() { return NULL; }
+        const_iterator end() const { return NULL; }
+        
+        T& operator[](AnalysisT* analysis)
+        {
+                size_t i = lowerBound(analysis);
+                if(i < index.size() && slots[index[i]].first == analysis)
+                        return slots[index[i]].second;
+                
+                size_t slot;
+                if(freeSlots.empty()) {
+                        slot = slots.size();
+                        slots.push_back(value_type(analysis, T()));
+                } else {
+                        slot = freeSlots.back();
+                        freeSlots.pop_back();
+                        slots[slot].first = analysis;
+                }
+                index.insert(index.begin() + i, slot);
+                return slots[slot].second;
+        }
+        
+        void erase(const AnalysisT* analysis)
+        {
+                size_t i = lowerBound(analysis);
+                if(i < index.size() && slots[index[i]].first == analysis) {
+                        size_t slot = index[i];
+                        slots[slot].first = NULL;
+                        slots[slot].second = T();
+                        freeSlots.push_back(slot);
+                        index.erase(index.begin() + i);
+                }
+        }
+        
+        size_t size() const { return index.size(); }
+        
+        private:
+        // Position in index of the first slot whose analysis is not less than analysis
+        size_t lowerBound(const AnalysisT* analysis) const
+        {
+                size_t lo = 0, hi = index.size();
+                while(lo < hi) {
+                        size_t mid = (lo + hi) / 2;
+                        if(std::less<const AnalysisT*>()(slots[index[mid]].first, analysis))
+                                lo = mid + 1;
+                        else
+                                hi = mid;
+                }
+                return lo;
+        }
+        
+        std::deque<value_type> slots;
+        // Slot numbers of the entries, sorted by analysis
+        std::vector<size_t> index;
+        // Slots of erased entries, reused by later insertions
+        std::vector<size_t> freeSlots;
+};
+
 class NodeState
 {
         #ifdef THREADED
@@ -94,10 +181,10 @@ class NodeState
         typedef tbb::concurrent_hash_map <Analysis*, std::vector<NodeFact*>, NodeStateHashCompare > NodeFactMap;
         typedef tbb::concurrent_hash_map <Analysis*, bool, NodeStateHashCompare  > BoolMap;     
         #else
-        typedef std::map<Analysis*, std::vector<Lattice*> > LatticeMap;
+        typedef AnalysisMap<std::vector<Lattice*> > LatticeMap;
         //typedef std::map<Analysis*, std::map<int, NodeFact*> > NodeFactMap;
-        typedef std::map<Analysis*, std::vector<NodeFact*> > NodeFactMap;
-        typedef std::map<Analysis*, bool > BoolMap;
+        typedef AnalysisMap<std::vector<NodeFact*> > NodeFactMap;
+        typedef AnalysisMap<bool> BoolMap;
         #endif
         
         // the dataflow information Above the node, for each analysis that 
@@ -284,7 +371,11 @@ class NodeState
         
         // ====== STATIC ======
         private:
-        static std::map<DataflowNode, std::vector<NodeState*> > nodeStateMap;
+        // The NodeStates of each CFG node, keyed by its SgNode and index. The NodeStates themselves are
+        // allocated contiguously, one array per function in the order in which its CFG is iterated.
+        typedef boost::unordered_map<std::pair<SgNode*, unsigned int>, std::vector<NodeState*> > NodeStateMap;
+        static NodeStateMap nodeStateMap;
+        static std::vector<std::vector<NodeState> > functionNodeStates;
         static bool nodeStateMapInit;
         
         public:
@@ -22,6 +22,10 @@ class PtrAnal
   bool may_alias(AstInterface& fa, const AstNodePtr& r1, const AstNodePtr& r2);
   VarRef translate_exp(const AstNodePtr& exp) const;
   StmtRef translate_stmt(const AstNodePtr& stmt) const;
+  // Forgets the translations of the expressions and statements analyzed so far, keeping the
+  // analysis results; call it after each translation unit so that memory does not grow with
+  // the size of the program.
+  void clear_translations();
 
   virtual bool may_alias(const std::string& x, const std::string& y) = 0;
   virtual Stmt x_eq_y(const std::string& x, const std::string& y) = 0; 
@@ -42,5 +42,6 @@ class SteensgaardPtrAnal : public PtrAnal, private ECRmap
 
  public:
   void output(std::ostream& out) { Impl::output(out); }
+  size_t number_of_locations() const { return Impl::number_of_locations(); }
 };
 #endif
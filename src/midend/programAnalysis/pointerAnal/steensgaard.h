@@ -4,9 +4,13 @@
 /******Author: Qing Yi, Andrew Long 2007 ********/
 
 #include <union_find.h>
+#include <boost/unordered_map.hpp>
+#include <algorithm>
+#include <deque>
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <assert.h>
 
@@ -14,16 +18,16 @@
 
 class ECR;
 struct Lambda {
-   std::list<ECR *> inParams, outParams;
-   std::list<ECR*>& get_inParams() { return inParams; }
-   std::list<ECR*>& get_outParams() { return outParams; }
+   std::vector<ECR *> inParams, outParams;
+   std::vector<ECR*>& get_inParams() { return inParams; }
+   std::vector<ECR*>& get_outParams() { return outParams; }
 }; ;
 
 class ECR : public UF_elem
 {
    ECR* type;
    Lambda* lambda;
-   std::list<ECR *> pending;
+   std::vector<ECR *> pending;
    ECR * find_group()
     {  return static_cast<ECR*>(UF_elem::find_group()); }
 
@@ -38,37 +42,58 @@ public:
    }
 
    ECR* get_ecr()  { return find_group(); }
-   ECR* get_type() { 
+   ECR* get_type() {
         ECR* g = find_group();
         return (g->type)? g->type->find_group() : g->type;
     }
-   void set_type(ECR *that) { 
+   void set_type(ECR *that) {
         ECR* g = find_group();
         g->type = that;
    }
-   std::list<ECR*>& get_pending() {return find_group()->pending;}
+   std::vector<ECR*>& get_pending() {return find_group()->pending;}
    Lambda* get_lambda() { return lambda; }
-   void set_lambda(Lambda* l) { lambda = l; } 
+   void set_lambda(Lambda* l) { lambda = l; }
 };
 
 #define Variable std::string
+
+// Steensgaard's points-to analysis.  Each variable is an abstract location with a dense integer id, and
+// constraints can be given either by variable name or by location.  The ECRs are allocated in blocks and
+// merged with union-find, so memory is proportional to the number of locations.
 class ECRmap {
  public:
-   class VariableAlreadyDefined { 
-       public: 
-         Variable var; 
+   typedef unsigned Location;
+   static Location no_location() { return (Location)(-1); }
+
+   class VariableAlreadyDefined {
+       public:
+         Variable var;
          VariableAlreadyDefined(const Variable& _var) : var(_var) {}
-   }; 
+   };
+
+   // The location of variable x, which is created if x has not been seen before.
+   Location get_location(const Variable& x) {
+      assert(x != "");
+      std::pair<LocationMap::iterator, bool> p = table.insert(std::make_pair(x, (Location)locations.size()));
+      if (p.second) {
+         locations.push_back(new_ECR());
+         names.push_back(&p.first->first);
+      }
+      return p.first->second;
+   }
+   size_t number_of_locations() const { return locations.size(); }
 
    // x = y
-   void x_eq_y(Variable x, Variable y) {
+   void x_eq_y(Variable x, Variable y) { x_eq_y(get_location(x), get_location(y)); }
+   void x_eq_y(Location x, Location y) {
       ECR* t1 = get_ECR(x)->get_type();
       ECR* t2 = get_ECR(y)->get_type();
       if (t1 != t2)
          cjoin(t1, t2);
    }
    // x = & y
-   void x_eq_addr_y(Variable x, Variable y) {
+   void x_eq_addr_y(Variable x, Variable y) { x_eq_addr_y(get_location(x), get_location(y)); }
+   void x_eq_addr_y(Location x, Location y) {
       ECR * t1 = get_ECR(x)->get_type();
       ECR * t2 = get_ECR(y);
       if (t1 != t2) {
@@ -76,7 +101,8 @@ class ECRmap {
       }
    }
    // x = *y
-   void x_eq_deref_y(Variable x, Variable y) {
+   void x_eq_deref_y(Variable x, Variable y) { x_eq_deref_y(get_location(x), get_location(y)); }
+   void x_eq_deref_y(Location x, Location y) {
       ECR* t1 = get_ECR(x)->get_type();
       ECR* t2 = get_ECR(y)->get_type();
       if (t2->get_type() == BOT) {
@@ -88,18 +114,22 @@ class ECRmap {
              cjoin(t1, t3);
          }
       }
-   }   
+   }
    // x = op(y1,...yn)
    void x_eq_op_y(Variable x, const std::list<Variable>& y) {
-      ECR* t1 = get_ECR(x)->get_type();
+      Location lx = get_location(x);
       for (std::list<Variable>::const_iterator yp = y.begin();
-           yp != y.end(); ++yp) {
-         ECR* t2 = get_ECR(*yp)->get_type();
-         if (t1 != t2) cjoin(t1, t2);
-      }
+           yp != y.end(); ++yp)
+         x_eq_y(lx, get_location(*yp));
+   }
+   void x_eq_op_y(Location x, const std::vector<Location>& y) {
+      for (std::vector<Location>::const_iterator yp = y.begin();
+           yp != y.end(); ++yp)
+         x_eq_y(x, *yp);
    }
   // allocate(x)
-  void allocate(Variable x) {
+  void allocate(Variable x) { allocate(get_location(x)); }
+  void allocate(Location x) {
       ECR* t = get_ECR(x)->get_type();
       if (t->get_type() == BOT) {
           ECR* res = new_ECR();
@@ -107,7 +137,8 @@ class ECRmap {
       }
   }
   // *x = y
-  void deref_x_eq_y(Variable x, Variable y) {
+  void deref_x_eq_y(Variable x, Variable y) { deref_x_eq_y(get_location(x), get_location(y)); }
+  void deref_x_eq_y(Location x, Location y) {
       ECR* t1 = get_ECR(x)->get_type();
       ECR* t2 = get_ECR(y)->get_type();
       if (t1->get_type() == BOT) {
@@ -115,12 +146,16 @@ class ECRmap {
       }
       else {
          ECR* t3 = t1->get_type();
-         if (t2 != t3) 
+         if (t2 != t3)
              cjoin(t3, t2);
       }
-   }   
+   }
   // outParams = x (inparams)
-  void function_def_x(Variable x, const std::list<Variable>& inParams, const std::list<Variable>& outParams) 
+  void function_def_x(Variable x, const std::list<Variable>& inParams, const std::list<Variable>& outParams)
+   {
+     function_def_x(get_location(x), get_locations(inParams), get_locations(outParams));
+   }
+  void function_def_x(Location x, const std::vector<Location>& inParams, const std::vector<Location>& outParams)
    {
      ECR* t = get_ECR(x)->get_type();
      Lambda* l = t->get_lambda();
@@ -130,8 +165,8 @@ class ECRmap {
         t->set_lambda(l);
      }
      else {
-       std::list<ECR *>::const_iterator p1=l->get_inParams().begin();
-       std::list<Variable>::const_iterator p2=inParams.begin();
+       std::vector<ECR *>::const_iterator p1=l->get_inParams().begin();
+       std::vector<Location>::const_iterator p2=inParams.begin();
         for ( ; p1 != l->get_inParams().end(); ++p1,++p2) {
            assert(p2 != inParams.end());
            join(*p1, get_ECR(*p2)->get_type());
@@ -144,10 +179,15 @@ class ECRmap {
            join(*p1, get_ECR(*p2)->get_type());
         }
         assert(p2 == outParams.end());
-     } 
+     }
    }
   // x = p (y)
   void function_call_p(Variable p, const std::list<Variable>& x, const std::list<Variable>& y)
+  {
+     function_call_p(get_location(p), get_locations(x), get_locations(y));
+  }
+  // Elements of x and y may be no_location() for results and arguments that are not variables.
+  void function_call_p(Location p, const std::vector<Location>& x, const std::vector<Location>& y)
   {
      ECR* t = get_ECR(p)->get_type();
      Lambda* l = t->get_lambda();
@@ -157,15 +197,14 @@ class ECRmap {
         t->set_lambda(l);
      }
      else {
-       std::list<ECR *>::const_iterator p1=l->get_inParams().begin();
-       std::list<Variable>::const_iterator p2=y.begin();
+       std::vector<ECR *>::const_iterator p1=l->get_inParams().begin();
+       std::vector<Location>::const_iterator p2=y.begin();
         for ( ; p1 != l->get_inParams().end(); ++p1,++p2) {
            assert(p2 != y.end());
           ECR* cur = *p1;
           assert(cur != 0);
-          Variable v2 = *p2;
-          if (v2 != "")
-             join(cur->get_ecr(), get_ECR(v2)->get_type());
+          if (*p2 != no_location())
+             join(cur->get_ecr(), get_ECR(*p2)->get_type());
         }
         assert(p2 == y.end());
         p1=l->get_outParams().begin();
@@ -174,12 +213,11 @@ class ECRmap {
            assert(p2 != x.end());
            ECR* cur = *p1;
           assert(cur != 0);
-          Variable v2 = *p2;
-           if ( v2 != "")
-           join(get_ECR(v2)->get_type(), cur->get_ecr());
+           if (*p2 != no_location())
+           join(get_ECR(*p2)->get_type(), cur->get_ecr());
         }
         assert(p2 == x.end());
-     } 
+     }
   }
 
   virtual void dump() { output(std::cerr); }
@@ -190,7 +228,7 @@ class ECRmap {
               if (p1 == locmap.end()) {
                   locmap[p] = ++loc;
                   cur = loc;
-              } 
+              }
               else
                  cur = p1->second;
       return cur;
@@ -208,94 +246,102 @@ class ECRmap {
         out << "=>" << "LOC" << cur << " ";
         if (p ->get_pending().size() != 0) {
            out << "(pending ";
-           for (std::list<ECR*>::const_iterator pp=p->get_pending().begin(); 
-                pp != p->get_pending().end(); ++pp) 
+           for (std::vector<ECR*>::const_iterator pp=p->get_pending().begin();
+                pp != p->get_pending().end(); ++pp)
                outputLOC(out,locmap, loc, (*pp)->get_ecr());
            out << ") ";
         }
         Lambda* t = p->get_lambda();
         if (t != 0) {
            out << "(inparams: ";
-           for (std::list<ECR*>::const_iterator pp=t->get_inParams().begin(); 
-                pp != t->get_inParams().end(); ++pp) 
+           for (std::vector<ECR*>::const_iterator pp=t->get_inParams().begin();
+                pp != t->get_inParams().end(); ++pp)
               outputLOC(out,locmap,loc,(*pp)->get_ecr());
            out << ") ";
            out << "->(outparams: ";
-           for (std::list<ECR*>::const_iterator pp=t->get_outParams().begin(); 
-                pp != t->get_outParams().end(); ++pp)  
+           for (std::vector<ECR*>::const_iterator pp=t->get_outParams().begin();
+                pp != t->get_outParams().end(); ++pp)
               outputLOC(out,locmap,loc,(*pp)->get_ecr());
            out << ") ";
        }
     }
   }
 
+  // Outputs the named locations in the order of their names.
   void output(std::ostream& out) {
       std::map<ECR*, int> locmap;
       int loc = 0;
-      for (std::map<Variable, ECR*>::iterator 
-           itMap = table.begin(); itMap != table.end(); itMap++) {
-           ECR* p = itMap->second->get_ecr();
-           out << itMap->first ;
+      std::vector<std::pair<const Variable*, Location> > sorted;
+      for (Location i = 0; i < names.size(); ++i)
+         sorted.push_back(std::make_pair(names[i], i));
+      std::sort(sorted.begin(), sorted.end(), LessName());
+      for (size_t i = 0; i < sorted.size(); ++i) {
+           ECR* p = locations[sorted[i].second]->get_ecr();
+           out << *sorted[i].first ;
            outputLOC(out,locmap,loc,p);
            out << "\n";
       }
    }
 
    bool mayAlias(Variable x, Variable y) {
-      if (table.find(x) == table.end() || table.find(y) == table.end()) 
-         return false;     
-      
-      if (table[x]->get_type() == table[y]->get_type())
-         return true;
-      else
+      LocationMap::const_iterator px = table.find(x), py = table.find(y);
+      if (px == table.end() || py == table.end())
          return false;
+      return mayAlias(px->second, py->second);
    }
-   virtual ~ECRmap() {
-      for (std::list<ECR*>::const_iterator p = ecrList.begin();
-           p != ecrList.end(); ++p) {
-          delete (*p);
-      }
+   bool mayAlias(Location x, Location y) {
+      return locations[x]->get_type() == locations[y]->get_type();
    }
+   virtual ~ECRmap() {}
 
  private:
-  std::map<Variable, ECR*> table;
-  std::list<ECR*> ecrList;
-  std::list<Lambda> lambdaList;
-  ECR* get_ECR(Variable x) {
-     assert(x != "");
-     std::map<Variable, ECR*>::const_iterator p = table.find(x);
-     ECR* res = 0;
-     if (p == table.end()) {
-        res = new_ECR();
-        table[x] = res;
-     }
-     else
-        res = (*p).second;
-     if (res->get_type() == 0) 
+  typedef boost::unordered_map<Variable, Location> LocationMap;
+  struct LessName {
+     bool operator()(const std::pair<const Variable*, Location>& a, const std::pair<const Variable*, Location>& b) const
+        { return *a.first < *b.first; }
+  };
+
+  LocationMap table;
+  std::vector<ECR*> locations;           // by location
+  std::vector<const Variable*> names;    // by location; the keys of table
+  std::deque<ECR> ecrs;                  // all ECRs; a deque never moves its elements
+  std::deque<Lambda> lambdas;
+
+  ECR* get_ECR(Location x) {
+     assert(x < locations.size());
+     ECR* res = locations[x];
+     if (res->get_type() == 0)
          res->set_type(new_ECR());
      return res;
   }
+  std::vector<Location> get_locations(const std::list<Variable>& vars) {
+     std::vector<Location> res;
+     res.reserve(vars.size());
+     for (std::list<Variable>::const_iterator p = vars.begin(); p != vars.end(); ++p)
+        res.push_back(*p != "" ? get_location(*p) : no_location());
+     return res;
+  }
   ECR* new_ECR() {
-     ecrList.push_back(new ECR());
-     return ecrList.back();
+     ecrs.push_back(ECR());
+     return &ecrs.back();
   }
   Lambda* new_Lambda() {
-     lambdaList.push_back(Lambda());
-     return &lambdaList.back();
+     lambdas.push_back(Lambda());
+     return &lambdas.back();
   }
-  void set_lambda(Lambda* l,const std::list<Variable>& inParams, const std::list<Variable>& outParams) {
-     for (std::list<Variable>::const_iterator p = inParams.begin();
+  void set_lambda(Lambda* l,const std::vector<Location>& inParams, const std::vector<Location>& outParams) {
+     l->get_inParams().reserve(inParams.size());
+     for (std::vector<Location>::const_iterator p = inParams.begin();
           p != inParams.end(); ++p) {
-        Variable cur = *p;
-        if (cur != "")
-           l->get_inParams().push_back(get_ECR(cur)->get_type());
+        if (*p != no_location())
+           l->get_inParams().push_back(get_ECR(*p)->get_type());
         else l->get_inParams().push_back(0);
      }
-     for (std::list<Variable>::const_iterator p2 = outParams.begin();
+     l->get_outParams().reserve(outParams.size());
+     for (std::vector<Location>::const_iterator p2 = outParams.begin();
           p2 != outParams.end(); ++p2) {
-        Variable cur = *p2;
-        if (cur != "")
-           l->get_outParams().push_back(get_ECR(cur)->get_type());
+        if (*p2 != no_location())
+           l->get_outParams().push_back(get_ECR(*p2)->get_type());
         else
            l->get_outParams().push_back(new_ECR());
      }
@@ -303,15 +349,15 @@ class ECRmap {
   void set_type(ECR * e, ECR * t) {
       e->set_type(t);
      assert(t != BOT && e->get_type() == t);
-      std::list<ECR*> pending = e->get_pending();
+      std::vector<ECR*> pending = e->get_pending();
       if (pending.size()) {
-         for (std::list<ECR*>::const_iterator p=pending.begin(); 
-              p != pending.end(); ++p) 
+         for (std::vector<ECR*>::const_iterator p=pending.begin();
+              p != pending.end(); ++p)
             join(t, *p);
          e->get_pending().clear();
       }
    }
-   
+
   void cjoin(ECR* e1, ECR* e2) {
       if (e2->get_type() == BOT) {
          e2->get_pending().push_back(e1);
@@ -322,8 +368,8 @@ class ECRmap {
 
   void unify_lambda(Lambda* l1, Lambda* l2)
   {
-        std::list<ECR *>::const_iterator p1=l1->get_inParams().begin();
-        std::list<ECR *>::const_iterator p2=l2->get_inParams().begin();
+        std::vector<ECR *>::const_iterator p1=l1->get_inParams().begin();
+        std::vector<ECR *>::const_iterator p2=l2->get_inParams().begin();
         for ( ; p1 != l1->get_inParams().end(); ++p1,++p2) {
            assert(p2 != l2->get_inParams().end());
            join(*p1, *p2);
@@ -355,20 +401,20 @@ class ECRmap {
       ECR* t2 = e2->get_type();
       Lambda* l1 = e1->get_lambda();
       Lambda* l2 = e2->get_lambda();
-      std::list<ECR*> *pending1 = &e1->get_pending(), *pending2 = &e2->get_pending();
+      std::vector<ECR*> *pending1 = &e1->get_pending(), *pending2 = &e2->get_pending();
       ECR* e = e1->union_with(e2);
       if (l1 == BOT) {
-         if (l2 != BOT) 
+         if (l2 != BOT)
            e->set_lambda(l2);
       }
       else {
          e->set_lambda(l1);
          if (l2 != BOT)
-            unify_lambda(l1,l2); 
+            unify_lambda(l1,l2);
       }
 
-      std::list<ECR*> *pending = &e->get_pending();
- 
+      std::vector<ECR*> *pending = &e->get_pending();
+
       if (t1 == BOT) {
          e->set_type(t2);
          if (t2 == BOT) {
@@ -387,22 +433,17 @@ class ECRmap {
               }
          }
          else {
-           if (pending1->size()) {
-              for (std::list<ECR*>::const_iterator p=pending1->begin();
-                   p != pending1->end(); ++p) 
-                 join(e, *p);
-            }
+           // by index: the joins may append to pending1
+           for (size_t p = 0; p < pending1->size(); ++p)
+              join(e, (*pending1)[p]);
             pending->clear();
         }
       }
       else {
          e->set_type(t1);
          if (t2 == BOT) {
-             if (pending2->size()) {
-               for (std::list<ECR*>::const_iterator p=pending2->begin();
-                    p != pending2->end(); ++p) 
-                  join(e, *p);
-             }
+             for (size_t p = 0; p < pending2->size(); ++p)
+                join(e, (*pending2)[p]);
          }
          else
             unify(t1, t2);
@@ -19,6 +19,7 @@
 #include <boost/foreach.hpp>
 #include <filteredCFG.h>
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 #include "reachingDef.h"
 #include "dataflowCfgFilter.h"
 #include "CallGraph.h"
@@ -130,9 +131,19 @@ private:
      * the values here cannot be used during interprocedural analysis.  */
     boost::unordered_map<SgNode*, NodeReachingDefTable> ssaLocalDefTable;
 
+    /** The functions processed by the last call to run(), plus those passed to rerunFunction(). */
+    boost::unordered_set<SgFunctionDefinition*> analyzedFunctions;
+
+    /** The options of the last call to run(), used by rerunFunction(). */
+    bool interproceduralDefsInserted;
+    bool pointersTreatedAsStructures;
+
+    class ParallelDataFlow;
+
 public:
 
-    StaticSingleAssignment(SgProject* proj) : project(proj)
+    StaticSingleAssignment(SgProject* proj) : project(proj), interproceduralDefsInserted(false),
+            pointersTreatedAsStructures(true)
     {
     }
 
@@ -146,6 +157,22 @@ public:
      * @param treatPointersAsStructures if true, p->x is versioned as if it were the variable p.x. */
     void run(bool interprocedural, bool treatPointersAsStructures);
 
+    /** Run the analysis, propagating the definitions of independent functions on nThreads threads.
+     * The local and interprocedural definitions are computed serially as in the single-threaded version; then each
+     * function's dataflow runs in a private set of tables which are merged into this object once all the threads have
+     * finished. The results are the same as with a single thread. Functions nested in other functions (e.g. member
+     * functions of local classes) are processed serially after the others.
+     * @param nThreads the number of threads; 0 or 1 processes all the functions in the calling thread. */
+    void run(bool interprocedural, bool treatPointersAsStructures, size_t nThreads);
+
+    /** Recompute the SSA form of a single function after its body has been transformed, using the options of the
+     * last call to run(). All the results for the nodes currently in the function are discarded and recomputed.
+     * Results for nodes that were removed from the function are not discarded. If the analysis is interprocedural,
+     * the definitions at the call sites in the function are recomputed from the current results of the callees, but
+     * the call sites of the function's callers are not updated; call run() again if the set of variables the function
+     * modifies has changed. */
+    void rerunFunction(SgFunctionDefinition* func);
+
     static bool getDebug()
     {
         return SgProject::get_verbose() > 0;
@@ -157,6 +184,13 @@ public:
     }
 
 private:
+    /** Collect the local defs and uses of a function and expand them for member variables. */
+    void insertLocalDefsAndUses(SgFunctionDefinition* func);
+
+    /** Insert phi functions, propagate the definitions along the CFG of the function and match its uses to their
+     * reaching definitions. The local and interprocedural defs of the function must already be in the def tables. */
+    void propagateDefsInFunction(SgFunctionDefinition* func);
+
     /** Once all the local definitions have been inserted in the ssaLocalDefsTable and phi functions have been inserted
      * in the reaching defs table, propagate reaching definitions along the CFG. */
     void runDefUseDataFlow(SgFunctionDefinition* func);
@@ -122,6 +122,28 @@ SDGNode*, SDGEdge*>
         boost::function<void(SgProject*, DefUseChains&)> defUseChainGenerator_;
 
 
+        //! A control dependence between two vertices of a function's CFG.
+        struct ControlDependence
+        {
+            CFGVertex controller;
+            CFGVertex dependent;
+            VirtualCFG::EdgeConditionKind condition;
+            SgExpression* caseLabel;
+        };
+
+        //! A table mapping each function to the control dependences in its CFG.
+        std::map<SgFunctionDeclaration*, std::vector<ControlDependence> > functionsToControlDependences_;
+
+        //! The def-use chains of the project, computed by the first build.
+        DefUseChains defUseChains_;
+        bool defUseChainsComputed_;
+
+        //! The number of threads building CFGs and computing summary edges.
+        size_t nThreads_;
+
+        //! The file in which summary edges are saved, or empty.
+        std::string summaryEdgesFile_;
+
         struct CallSiteInfo
         {
             CallSiteInfo() : funcCall(NULL), isVoid(true) {}
@@ -138,17 +160,41 @@ SDGNode*, SDGEdge*>
 
     public:
         SystemDependenceGraph(SgProject* project, StaticCFG::CFGNodeFilter filter)
-            : project_(project), cfgNodefilter_(filter)
+            : project_(project), cfgNodefilter_(filter), defUseChainsComputed_(false), nThreads_(1)
         {}
 
-        //! Build the SDG.
+        ~SystemDependenceGraph();
+
+        //! Build the SDG. The CFGs, control dependences and def-use chains computed by a previous
+        //! build are reused, so the SDG can be rebuilt cheaply (e.g. between slicing queries).
         void build();
 
         void setCFGNodeFilter(StaticCFG::CFGNodeFilter filter)
-        { cfgNodefilter_ = filter; }
+        { cfgNodefilter_ = filter; clearCaches(); }
 
         void setDefUseChainsGenerator(const DefUseChainsGen& defUseChainsGen)
-        { defUseChainGenerator_ = defUseChainsGen; }
+        { defUseChainGenerator_ = defUseChainsGen; defUseChains_.clear(); defUseChainsComputed_ = false; }
+
+        //! Set the number of threads building the CFGs and control dependences of the functions
+        //! and computing summary edges (default 1).
+        void setNumberOfThreads(size_t n)
+        { nThreads_ = n; }
+
+        //! Set a file in which summary edges are kept. If the file was written by a build of the same
+        //! graph, the summary edges are read from it instead of being computed; otherwise they are
+        //! computed and the file is rewritten.
+        void setSummaryEdgesFile(const std::string& filename)
+        { summaryEdgesFile_ = filename; }
+
+        //! Discard the cached CFGs, control dependences and def-use chains. This must be called
+        //! after the AST is modified.
+        void clearCaches();
+
+        //! Get the CFG of a function, or NULL if the function has not been built.
+        const CFG* getCFG(SgFunctionDeclaration* funcDecl) const;
+
+        //! Get the def-use chains of the project, computing them if necessary.
+        const DefUseChains& getDefUseChains();
 
 
         //! Write the PDG to a dot file.
@@ -172,9 +218,35 @@ SDGNode*, SDGEdge*>
         //! Add a Control Dependence edge with True label.
         void addTrueCDEdge(Vertex src, Vertex tgt);
 
+        //! Build the CFGs and control dependences of the functions which are not cached yet.
+        void buildFunctionCFGs(const std::vector<SgFunctionDefinition*>& funcDefs);
+
+        //! Compute the control dependences in a CFG.
+        static void computeControlDependences(const CFG& cfg, std::vector<ControlDependence>& controlDependences);
+
         void addControlDependenceEdges(
                 const boost::unordered_map<CFGVertex, Vertex>& cfgVerticesToSdgVertices,
-                const CFG& cfg, Vertex entry);
+                const std::vector<ControlDependence>& controlDependences, Vertex entry);
+
+        //! Compute the summary edges from each actual-in to the actual-outs it reaches.
+        void computeSummaryEdges(const std::vector<CallSiteInfo>& callSiteInfo,
+                std::vector<std::pair<Vertex, Vertex> >& summaryEdges) const;
+
+        //! A hash of the graph and call sites, identifying the graph in the summary edges file.
+        uint64_t summaryEdgesSignature(const std::vector<CallSiteInfo>& callSiteInfo) const;
+
+        bool loadSummaryEdges(uint64_t signature, std::vector<std::pair<Vertex, Vertex> >& summaryEdges) const;
+        void saveSummaryEdges(uint64_t signature, const std::vector<std::pair<Vertex, Vertex> >& summaryEdges) const;
+
+        //! Remove and delete all vertices and edges.
+        void clearGraph();
+
+    private:
+        //! The vertices and edges are owned by the graph, which therefore cannot be copied.
+        SystemDependenceGraph(const SystemDependenceGraph&);
+        SystemDependenceGraph& operator=(const SystemDependenceGraph&);
+
+    protected:
 
         void addDataDependenceEdges(
                 const boost::unordered_map<SgNode*, Vertex>& astNodesToSdgVertices,
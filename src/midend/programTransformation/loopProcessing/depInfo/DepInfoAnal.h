@@ -70,11 +70,40 @@ class DepInfoAnal
                       DepInfoCollect &outDeps, DepInfoCollect &inDeps, 
                       int deptype = DEPTYPE_DATA);
 
+  /* Subscripts of an array reference decomposed into affine functions of the
+     induction variables enclosing its statement: for each subscript, the
+     coefficients of the ivars and the remaining term (NIL if the subscript
+     is not affine). Index 0 decomposes the subscripts, index 1 their
+     negation, as used for the source and sink of a dependence. */
+  struct RefSubscriptInfo {
+     std::vector<SymbolicVal> subscripts;
+     bool decomposed[2];
+     std::vector< std::vector<SymbolicVal> > coeff[2];
+     std::vector<SymbolicVal> left[2];
+     RefSubscriptInfo() { decomposed[0] = decomposed[1] = false; }
+  };
+  const RefSubscriptInfo& GetRefSubscriptInfo( const AstNodePtr& s, 
+                                   const AstNodePtr& ref, int negate);
+  // Array dependence between two references, memoized per reference pair
+  DepInfo TestArrayDep( const StmtRefDep& ref, DepType deptype);
+
   AstInterface& get_astInterface() { return varmodInfo.get_astInterface(); }
 
  private:
+        struct ArrayDepKey {
+           AstNodePtr s1, r1, s2, r2;
+           int commLevel, deptype;
+           ArrayDepKey( const StmtRefDep& ref, DepType t)
+             : s1(ref.r1.stmt), r1(ref.r1.ref), s2(ref.r2.stmt), r2(ref.r2.ref),
+               commLevel(ref.commLevel), deptype(t) {}
+           bool operator < (const ArrayDepKey& that) const;
+        };
+        typedef std::pair<AstNodePtr,AstNodePtr> StmtRefPair;
+
         DependenceTesting& handle;
         std::map <AstNodePtr, LoopDepInfo, std::less <AstNodePtr> > stmtInfo;
+        std::map <StmtRefPair, RefSubscriptInfo, std::less<StmtRefPair> > refInfo;
+        std::map <ArrayDepKey, DepInfo, std::less<ArrayDepKey> > arrayDepInfo;
         ModifyVariableInfo varmodInfo;
 };
 
@@ -29,6 +29,15 @@ class ROSE_DLL_API LoopTransformOptions
           std::string GetExpl() const { return expl; }
           virtual ~OptRegistryType() {}
          };
+  /* Counters of the dependence analysis, accumulated over all loop nests;
+     printed after the dependence analysis of each nest with -depstats. */
+  struct DepAnalStatistics {
+       unsigned long refPairs, arrayTests, arrayTestsReused, subscriptsReused;
+       double arrayTestTime; // CPU seconds spent in array dependence tests
+       DepAnalStatistics() 
+         : refPairs(0), arrayTests(0), arrayTestsReused(0), subscriptsReused(0),
+           arrayTestTime(0) {}
+  };
  private:
   static LoopTransformOptions *inst;
 
@@ -40,6 +49,8 @@ class ROSE_DLL_API LoopTransformOptions
   LoopPar * parOp;
   CopyArrayOperator* cpOp;
   unsigned cacheline, reuseDist, splitlimit, defaultblocksize, parblocksize;
+  bool depstats, depcache, depgraph;
+  DepAnalStatistics depAnalStats;
   LoopTransformOptions();
   ~LoopTransformOptions();
 
@@ -62,6 +73,16 @@ class ROSE_DLL_API LoopTransformOptions
   void SetDefaultBlockSize(unsigned size) { defaultblocksize = size; }
   void SetParBlockSize(unsigned size) { parblocksize = size; }
   bool DoDynamicTuning() const;
+  bool DoReportDepAnalStatistics() const { return depstats; }
+  void SetReportDepAnalStatistics(bool sel) { depstats = sel; }
+  DepAnalStatistics& GetDepAnalStatistics() { return depAnalStats; }
+  void ResetDepAnalStatistics() { depAnalStats = DepAnalStatistics(); }
+  void PrintDepAnalStatistics(std::ostream& stream) const;
+  // whether DepInfoAnal reuses subscript decompositions and array dependence results
+  bool DoDepAnalCache() const { return depcache; }
+  void SetDepAnalCache(bool sel) { depcache = sel; }
+  bool DoReportDepGraph() const { return depgraph; }
+  void SetReportDepGraph(bool sel) { depgraph = sel; }
   unsigned GetDynamicTuningIndex() const;
 
   typedef enum {NO_OPT = 0, LOOP_NEST_OPT = 1, INNER_MOST_OPT = 2, MULTI_LEVEL_OPT = 3, LOOP_OPT = 3, DATA_OPT = 4, LOOP_DATA_OPT = 7, PAR_OPT=8, PAR_LOOP_OPT=11, PAR_LOOP_DATA_OPT=15} OptType;
@@ -44,6 +44,7 @@ namespace ELF{
 #include "AstReverseProcessing.h"
 #include "AstPDFGeneration.h"
 #include "AstDOTGeneration.h"
+#include "AstStreamingGraphGeneration.h"
 #include "AstDiagnostics.h"
 // #include "AstStatistics.h"
 #include "RoseAst.h"
@@ -64,20 +64,48 @@ public:
     typedef BitVectorSupport::BitRange BitRange;        /**< Describes an inclusive interval of bit indices. */
 
 private:
-    std::vector<Word> words_;
+    // Vectors of up to 128 bits keep their words in the object itself so that creating and copying the many small vectors
+    // that hold register-sized values doesn't allocate. Larger vectors keep their words in words_.
+    enum { nInlineWords = 128 / BitVectorSupport::bitsPerWord<Word>::value };
+    Word inlineWords_[nInlineWords];
+    std::vector<Word> words_;                           // storage for vectors that don't fit in inlineWords_, otherwise empty
     size_t size_;
 
+    bool isInline() const {
+        return BitVectorSupport::numberOfWords<Word>(size_) <= nInlineWords;
+    }
+
+    // Inline words are copied all at once, including those past the end of the vector. A copy of constant size compiles to a
+    // few moves, while a copy of dataSize() words may become a string instruction that costs more than the copy itself.
+    // Constructors therefore give every inline word a value.
+    void clearInlineWords() {
+        std::fill(inlineWords_, inlineWords_ + nInlineWords, Word(0));
+    }
+
+    void copyInlineWords(const BitVector &other) {
+        std::copy(other.inlineWords_, other.inlineWords_ + nInlineWords, inlineWords_);
+    }
+
 public:
     /** Default construct an empty vector. */
-    BitVector(): size_(0) {}
+    BitVector(): size_(0) {
+        clearInlineWords();
+    }
 
     /** Copy constructor. */
-    BitVector(const BitVector &other): words_(other.words_), size_(other.size_) {}
+    BitVector(const BitVector &other): size_(other.size_) {
+        if (other.isInline()) {
+            copyInlineWords(other);
+        } else {
+            words_ = other.words_;
+        }
+    }
 
     /** Create a vector of specified size.
      *
      *  All bits in this vector will be set to the @p newBits value. */
     explicit BitVector(size_t nbits, bool newBits = false): size_(0) {
+        clearInlineWords();
         resize(nbits, newBits);
     }
 
@@ -162,7 +190,12 @@ public:
      *
      *  @sa The @ref copy method is similar but does not change the size of the destination vector. */
     BitVector& operator=(const BitVector &other) {
-        words_ = other.words_;
+        if (other.isInline()) {
+            copyInlineWords(other);
+            words_.clear();
+        } else {
+            words_ = other.words_;
+        }
         size_ = other.size_;
         return *this;
     }
@@ -181,21 +214,25 @@ public:
      *
      *  Changes the size of a vector, measured in bits, by either adding or removing bits from the most-significant side of
      *  this vector.  If new bits are added they are each given the value @p newBits.  Increasing the size of a vector may
-     *  cause it to reallocate and copy its internal data structures. */
+     *  cause it to reallocate and copy its internal data structures. Vectors of 128 bits or less never allocate. */
     BitVector& resize(size_t newSize, bool newBits=false) {
-        if (0==newSize) {
-            words_.clear();
-            size_ = 0;
-        } else if (newSize > size_) {
-            size_t nwords = BitVectorSupport::numberOfWords<Word>(newSize);
-            words_.resize(nwords, Word(0));
-            BitVectorSupport::setValue(data(), BitRange::hull(size_, newSize-1), newBits);
-            size_ = newSize;
+        size_t oldSize = size_;
+        size_t oldWords = dataSize();
+        size_t newWords = BitVectorSupport::numberOfWords<Word>(newSize);
+        if (newWords <= nInlineWords) {
+            if (oldWords > nInlineWords) {
+                std::copy(words_.begin(), words_.begin() + newWords, inlineWords_);
+                words_.clear();
+            }
+            std::fill(inlineWords_ + std::min(oldWords, newWords), inlineWords_ + newWords, Word(0));
         } else {
-            size_t nwords = BitVectorSupport::numberOfWords<Word>(newSize);
-            words_.resize(nwords);
-            size_ = newSize;
+            if (oldWords <= nInlineWords)
+                words_.assign(inlineWords_, inlineWords_ + oldWords);
+            words_.resize(newWords, Word(0));
         }
+        size_ = newSize;
+        if (newSize > oldSize)
+            BitVectorSupport::setValue(data(), BitRange::hull(oldSize, newSize-1), newBits);
         return *this;
     }
 
@@ -204,7 +241,7 @@ public:
      *  Returns the maximum number of bits to which this vector could be resized via @ref resize before it becomes necessary to
      *  reallocate its internal data structures. */
     size_t capacity() const {
-        return BitVectorSupport::bitsPerWord<Word>::value * words_.capacity();
+        return BitVectorSupport::bitsPerWord<Word>::value * std::max((size_t)nInlineWords, words_.capacity());
     }
 
     /** Interval representing the entire vector.
@@ -1312,11 +1349,15 @@ public:
      *
      *  @{ */
     Word* data() {
-        return words_.empty() ? NULL : &words_[0];
+        if (0 == size_)
+            return NULL;
+        return isInline() ? inlineWords_ : &words_[0];
     }
 
     const Word* data() const {
-        return words_.empty() ? NULL : &words_[0];
+        if (0 == size_)
+            return NULL;
+        return isInline() ? inlineWords_ : &words_[0];
     }
     /** @} */
 
@@ -1324,7 +1365,7 @@ public:
      *
      *  Returns the number of elements of type Word in the array returned by the @ref data method. */
     size_t dataSize() const {
-        return words_.size();
+        return BitVectorSupport::numberOfWords<Word>(size_);
     }
 };
 
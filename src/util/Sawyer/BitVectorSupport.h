@@ -13,6 +13,7 @@
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 #include <cstring>
+#include <functional>
 #include <Sawyer/Assert.h>
 #include <Sawyer/Interval.h>
 #include <Sawyer/Optional.h>
@@ -75,6 +76,59 @@ Word bitMask(size_t offset, size_t nbits) {
     return mask << offset;
 }
 
+/** Number of set bits in a word.
+ *
+ *  Uses the compiler's population count builtin when available, which is a single instruction on most hardware. */
+template<class Word>
+size_t nSetInWord(Word word) {
+#ifdef __GNUC__
+    if (sizeof(Word) <= sizeof(unsigned))
+        return __builtin_popcount((unsigned)word);
+    return __builtin_popcountll((unsigned long long)word);
+#else
+    size_t n = 0;
+    for (/*void*/; word != 0; word &= word - 1)
+        ++n;
+    return n;
+#endif
+}
+
+/** Index of the least significant set bit in a word.
+ *
+ *  The word must not be zero. */
+template<class Word>
+size_t leastSignificantSetBitInWord(Word word) {
+    ASSERT_require(word != 0);
+#ifdef __GNUC__
+    if (sizeof(Word) <= sizeof(unsigned))
+        return __builtin_ctz((unsigned)word);
+    return __builtin_ctzll((unsigned long long)word);
+#else
+    size_t i = 0;
+    for (/*void*/; 0 == (word & Word(1)); word >>= 1)
+        ++i;
+    return i;
+#endif
+}
+
+/** Index of the most significant set bit in a word.
+ *
+ *  The word must not be zero. */
+template<class Word>
+size_t mostSignificantSetBitInWord(Word word) {
+    ASSERT_require(word != 0);
+#ifdef __GNUC__
+    if (sizeof(Word) <= sizeof(unsigned))
+        return 8 * sizeof(unsigned) - 1 - __builtin_clz((unsigned)word);
+    return 8 * sizeof(unsigned long long) - 1 - __builtin_clzll((unsigned long long)word);
+#else
+    size_t i = 0;
+    for (word >>= 1; word != 0; word >>= 1)
+        ++i;
+    return i;
+#endif
+}
+
 /** Invoke the a processor for a vector traversal.
  *
  *  Returns true when the word is "found" and the traversal can abort.
@@ -133,11 +187,11 @@ bool processWord(Processor &processor, const Word &w1, const Word &w2, size_t sh
 }
 /** @} */
 
-// Internal function to copy bits from one place to another. The two places must not overlap.
+// Internal function to copy bits from one place to another.  The two places may overlap, in which case the words are copied
+// in whichever order reads each source word before it is overwritten. No temporary storage is needed.
 template<class Word>
-void nonoverlappingCopy(const Word *src, const BitRange &srcRange, Word *dst, const BitRange &dstRange) {
+void copyWords(const Word *src, const BitRange &srcRange, Word *dst, const BitRange &dstRange) {
     ASSERT_require(srcRange.size()==dstRange.size());
-    ASSERT_require(src != dst);
 
     size_t dstFirstIdx = wordIndex<Word>(dstRange.least());
     size_t dstLastIdx  = wordIndex<Word>(dstRange.greatest());
@@ -149,56 +203,44 @@ void nonoverlappingCopy(const Word *src, const BitRange &srcRange, Word *dst, co
     size_t srcBitIdx = bitIndex<Word>(srcRange.least());
     size_t dstBitIdx = bitIndex<Word>(dstRange.least());
 
-    if (srcBitIdx < dstBitIdx) {
-        // This is effectively a left shift, taking data from lower src elements
-        const size_t leftShiftAmount = dstBitIdx - srcBitIdx;
-        const size_t rightShiftAmount = bitsPerWord<Word>::value - leftShiftAmount;
-
-        for (size_t i=dstFirstIdx; i<=dstLastIdx; ++i) {
-            const Word tmp = (i+srcOffset > srcFirstIdx ? (src[i+srcOffset-1] >> rightShiftAmount) : Word(0)) |
-                             (src[i+srcOffset] << leftShiftAmount);
-            Word mask = bitMask<Word>(0, bitsPerWord<Word>::value);
-            if (i==dstFirstIdx)
-                mask &= ~bitMask<Word>(0, bitIndex<Word>(dstRange.least()));
-            if (i==dstLastIdx)
-                mask &= bitMask<Word>(0, bitIndex<Word>(dstRange.greatest())+1);
-            dst[i] &= ~mask;
-            dst[i] |= tmp & mask;
-        }
-    } else if (srcBitIdx > dstBitIdx) {
-        // This is effectively a right shift, taking data from higher src elements
-        const size_t rightShiftAmount = srcBitIdx - dstBitIdx;
-        const size_t leftShiftAmount = bitsPerWord<Word>::value - rightShiftAmount;
-
-        for (size_t i=dstFirstIdx; i<=dstLastIdx; ++i) {
-            const Word tmp = (src[i+srcOffset] >> rightShiftAmount) |
-                             (i+srcOffset+1 <= srcLastIdx ? (src[i+srcOffset+1] << leftShiftAmount) : Word(0));
-            Word mask = bitMask<Word>(0, bitsPerWord<Word>::value);
-            if (i==dstFirstIdx)
-                mask &= ~bitMask<Word>(0, bitIndex<Word>(dstRange.least()));
-            if (i==dstLastIdx)
-                mask &= bitMask<Word>(0, bitIndex<Word>(dstRange.greatest())+1);
-            dst[i] &= ~mask;
-            dst[i] |= tmp & mask;
-        }
-    } else {
-        // No shifting necessary
-        for (size_t i=dstFirstIdx; i<=dstLastIdx; ++i) {
-            const Word tmp = src[i+srcOffset];
-            Word mask = bitMask<Word>(0, bitsPerWord<Word>::value);
-            if (i==dstFirstIdx)
-                mask &= ~bitMask<Word>(0, bitIndex<Word>(dstRange.least()));
-            if (i==dstLastIdx)
-                mask &= bitMask<Word>(0, bitIndex<Word>(dstRange.greatest())+1);
-            dst[i] &= ~mask;
-            dst[i] |= tmp & mask;
+    // A destination that starts above an overlapping source must be written from its most significant word down, otherwise
+    // from its least significant word up.  Either order works when they don't overlap.
+    const Word *srcFirst = src + srcFirstIdx, *dstFirst = dst + dstFirstIdx;
+    bool highToLow = std::less<const Word*>()(srcFirst, dstFirst) || (srcFirst == dstFirst && srcBitIdx < dstBitIdx);
+
+    const size_t nWords = dstLastIdx - dstFirstIdx + 1;
+    for (size_t n=0; n<nWords; ++n) {
+        size_t i = highToLow ? dstLastIdx - n : dstFirstIdx + n;
+        Word tmp;
+        if (srcBitIdx < dstBitIdx) {
+            // This is effectively a left shift, taking data from lower src elements
+            const size_t leftShiftAmount = dstBitIdx - srcBitIdx;
+            const size_t rightShiftAmount = bitsPerWord<Word>::value - leftShiftAmount;
+            tmp = (i+srcOffset > srcFirstIdx ? (src[i+srcOffset-1] >> rightShiftAmount) : Word(0)) |
+                  (i+srcOffset <= srcLastIdx ? (src[i+srcOffset] << leftShiftAmount) : Word(0));
+        } else if (srcBitIdx > dstBitIdx) {
+            // This is effectively a right shift, taking data from higher src elements
+            const size_t rightShiftAmount = srcBitIdx - dstBitIdx;
+            const size_t leftShiftAmount = bitsPerWord<Word>::value - rightShiftAmount;
+            tmp = (src[i+srcOffset] >> rightShiftAmount) |
+                  (i+srcOffset+1 <= srcLastIdx ? (src[i+srcOffset+1] << leftShiftAmount) : Word(0));
+        } else {
+            // No shifting necessary
+            tmp = src[i+srcOffset];
         }
+        Word mask = bitMask<Word>(0, bitsPerWord<Word>::value);
+        if (i==dstFirstIdx)
+            mask &= ~bitMask<Word>(0, dstBitIdx);
+        if (i==dstLastIdx)
+            mask &= bitMask<Word>(0, bitIndex<Word>(dstRange.greatest())+1);
+        dst[i] &= ~mask;
+        dst[i] |= tmp & mask;
     }
 }
 
 template<class Src, class Dst>
 void conditionalCopy(const Src *src, const BitRange &srcRange, Dst *dst, const BitRange &dstRange) {
-    nonoverlappingCopy(src, srcRange, dst, dstRange);
+    copyWords(src, srcRange, dst, dstRange);
 }
 template<class Src, class Dst>
 void conditionalCopy(const Src *src, const BitRange &srcRange, const Dst *dst, const BitRange &dstRange) {
@@ -258,6 +300,29 @@ void traverse(Processor &processor, Word *words, const BitRange &range, HighToLo
     }
 }
 
+// True if two equal-size ranges start at the same bit within their words and their words are either the same words or don't
+// overlap at all.  Such ranges can be traversed in place a word at a time without first copying one of them.
+template<class Word1, class Word2>
+bool isAlignedInPlace(Word1 *vec1, const BitRange &range1, Word2 *vec2, const BitRange &range2) {
+    size_t offsetInWord = bitIndex<Word2>(range2.least());
+    if (bitIndex<Word1>(range1.least()) != offsetInWord)
+        return false;
+    const char *w1 = (const char*)(vec1 + wordIndex<Word1>(range1.least()));
+    const char *w2 = (const char*)(vec2 + wordIndex<Word2>(range2.least()));
+    size_t nBytes = numberOfWords<Word2>(offsetInWord + range2.size()) * sizeof(Word2);
+    std::less_equal<const char*> isNotAfter;
+    return w1 == w2 || isNotAfter(w1 + nBytes, w2) || isNotAfter(w2 + nBytes, w1);
+}
+
+// Number of bits of a range that are stored in the word at wordIdx (counted from the range's first word), when the range
+// starts at bit offsetInWord of its first word.
+template<class Word>
+size_t bitsInWord(size_t wordIdx, size_t offsetInWord, size_t rangeSize) {
+    size_t lo = 0 == wordIdx ? offsetInWord : 0;
+    size_t hi = std::min((size_t)bitsPerWord<Word>::value, offsetInWord + rangeSize - wordIdx * bitsPerWord<Word>::value);
+    return hi - lo;
+}
+
 /** Traverse two ranges of bits from low to high. */
 template<class Processor, class Word1, class Word2>
 void traverse2(Processor &processor, Word1 *vec1, const BitRange &range1, Word2 *vec2, const BitRange &range2, LowToHigh) {
@@ -267,6 +332,20 @@ void traverse2(Processor &processor, Word1 *vec1, const BitRange &range1, Word2
         return;
     ASSERT_require(range1.size() == range2.size());
 
+    // Ranges with the same alignment are traversed in place, avoiding the copy below.
+    if (isAlignedInPlace(vec1, range1, vec2, range2)) {
+        size_t offsetInWord = bitIndex<Word2>(range2.least());
+        Word1 *w1 = vec1 + wordIndex<Word1>(range1.least());
+        Word2 *w2 = vec2 + wordIndex<Word2>(range2.least());
+        const size_t nWords = numberOfWords<Word2>(offsetInWord + range2.size());
+        bool done = false;
+        for (size_t wordIdx=0; !done && wordIdx < nWords; ++wordIdx) {
+            done = processWord(processor, w1[wordIdx], w2[wordIdx], wordIdx==0 ? offsetInWord : 0,
+                               bitsInWord<Word2>(wordIdx, offsetInWord, range2.size()));
+        }
+        return;
+    }
+
     // Make a copy of the source and give it the same bit alignment as the destination.  This not only makes traversal easier
     // (since we can traverse whole words at a time) but it also makes it so we don't need to worry about traversal order when
     // the source and destination overlap.
@@ -275,7 +354,7 @@ void traverse2(Processor &processor, Word1 *vec1, const BitRange &range1, Word2
     SAWYER_VARIABLE_LENGTH_ARRAY(typename RemoveConst<Word1>::Base, tmp, nWordsTmp);
     memset(tmp, 0, nWordsTmp*sizeof(*tmp));                         // only for making debugging easier
     BitRange tmpRange = BitRange::baseSize(offsetInWord, range1.size());
-    nonoverlappingCopy(vec1, range1, tmp, tmpRange);
+    copyWords(vec1, range1, tmp, tmpRange);
 
     // Do the traversal.  The first iteration's words are offset by offsetInWord bits, the remainder start at bit zero. All the
     // words except possibly the first and last are the full size.
@@ -304,6 +383,20 @@ void traverse2(Processor &processor, Word1 *vec1, const BitRange &range1, Word2
         return;
     ASSERT_require(range1.size() == range2.size());
 
+    // Ranges with the same alignment are traversed in place, avoiding the copy below.
+    if (isAlignedInPlace(vec1, range1, vec2, range2)) {
+        size_t offsetInWord = bitIndex<Word2>(range2.least());
+        Word1 *w1 = vec1 + wordIndex<Word1>(range1.least());
+        Word2 *w2 = vec2 + wordIndex<Word2>(range2.least());
+        const size_t nWords = numberOfWords<Word2>(offsetInWord + range2.size());
+        bool done = false;
+        for (size_t wordIdx=nWords; !done && wordIdx > 0; --wordIdx) {
+            done = processWord(processor, w1[wordIdx-1], w2[wordIdx-1], wordIdx==1 ? offsetInWord : 0,
+                               bitsInWord<Word2>(wordIdx-1, offsetInWord, range2.size()));
+        }
+        return;
+    }
+
     // Make a copy of the source and give it the same bit alignment as the destination.  This not only makes traversal easier
     // (since we can traverse whole words at a time) but it also makes it so we don't need to worry about traversal order when
     // the source and destination overlap.
@@ -311,7 +404,7 @@ void traverse2(Processor &processor, Word1 *vec1, const BitRange &range1, Word2
     const size_t nWordsTmp = numberOfWords<Word2>(offsetInWord + range2.size());
     SAWYER_VARIABLE_LENGTH_ARRAY(typename RemoveConst<Word1>::Base, tmp, nWordsTmp);
     BitRange tmpRange = BitRange::baseSize(offsetInWord, range1.size());
-    nonoverlappingCopy(vec1, range1, tmp, tmpRange);
+    copyWords(vec1, range1, tmp, tmpRange);
 
     // Traversal high-to-low.
     size_t nRemaining = range2.size();
@@ -447,8 +540,9 @@ struct CopyBits {
  *  must be the same. The ranges may overlap, and the @p src and @p dst may be the same pointer. */
 template<class Word>
 void copy(const Word *src, const BitRange &srcRange, Word *dst, const BitRange &dstRange) {
-    CopyBits<Word> visitor;
-    traverse(visitor, src, srcRange, dst, dstRange, LowToHigh());
+    ASSERT_require(srcRange.size()==dstRange.size());
+    if (!srcRange.isEmpty())
+        copyWords(src, srcRange, dst, dstRange);
 }
 
 template<class Word>
@@ -486,13 +580,10 @@ struct LeastSignificantSetBit {
     Optional<size_t> result;
     LeastSignificantSetBit(): offset(0) {}
     bool operator()(const Word &word, size_t nbits) {
-        if (0 != (word & bitMask<Word>(0, nbits))) {
-            for (size_t i=0; i<nbits; ++i) {
-                if (0 != (word & bitMask<Word>(i, 1))) {
-                    result = offset + i;
-                    return true;
-                }
-            }
+        Word tmp = word & bitMask<Word>(0, nbits);
+        if (tmp != 0) {
+            result = offset + leastSignificantSetBitInWord(tmp);
+            return true;
         }
         offset += nbits;
         return false;
@@ -518,13 +609,10 @@ struct LeastSignificantClearBit {
     Optional<size_t> result;
     LeastSignificantClearBit(): offset(0) {}
     bool operator()(const Word &word, size_t nbits) {
-        if (bitMask<Word>(0, nbits) != (word & bitMask<Word>(0, nbits))) {
-            for (size_t i=0; i<nbits; ++i) {
-                if (0 == (word & bitMask<Word>(i, 1))) {
-                    result = offset + i;
-                    return true;
-                }
-            }
+        Word tmp = ~word & bitMask<Word>(0, nbits);
+        if (tmp != 0) {
+            result = offset + leastSignificantSetBitInWord(tmp);
+            return true;
         }
         offset += nbits;
         return false;
@@ -552,13 +640,10 @@ struct MostSignificantSetBit {
     bool operator()(const Word &word, size_t nbits) {
         ASSERT_require(nbits <= offset);
         offset -= nbits;
-        if (0 != (word & bitMask<Word>(0, nbits))) {
-            for (size_t i=nbits; i>0; --i) {
-                if (0 != (word & bitMask<Word>(i-1, 1))) {
-                    result = offset + i-1;
-                    return true;
-                }
-            }
+        Word tmp = word & bitMask<Word>(0, nbits);
+        if (tmp != 0) {
+            result = offset + mostSignificantSetBitInWord(tmp);
+            return true;
         }
         return false;
     }
@@ -585,13 +670,10 @@ struct MostSignificantClearBit {
     bool operator()(const Word &word, size_t nbits) {
         ASSERT_require(nbits <= offset);
         offset -= nbits;
-        if (bitMask<Word>(0, nbits) != (word & bitMask<Word>(0, nbits))) {
-            for (size_t i=nbits; i>0; --i) {
-                if (0 == (word & bitMask<Word>(i-1, 1))) {
-                    result = offset + i-1;
-                    return true;
-                }
-            }
+        Word tmp = ~word & bitMask<Word>(0, nbits);
+        if (tmp != 0) {
+            result = offset + mostSignificantSetBitInWord(tmp);
+            return true;
         }
         return false;
     }
@@ -631,12 +713,7 @@ struct CountSetBits {
     size_t result;
     CountSetBits(): result(0) {}
     bool operator()(const Word &word, size_t nbits) {
-        if (0 != (word & bitMask<Word>(0, nbits))) {
-            for (size_t i=0; i<nbits; ++i) {
-                if (0 != (word & bitMask<Word>(i, 1)))
-                    ++result;
-            }
-        }
+        result += nSetInWord<Word>(word & bitMask<Word>(0, nbits));
         return false;
     }
 };
@@ -656,12 +733,7 @@ struct CountClearBits {
     size_t result;
     CountClearBits(): result(0) {}
     bool operator()(const Word &word, size_t nbits) {
-        if (bitMask<Word>(0, nbits) != (word & bitMask<Word>(0, nbits))) {
-            for (size_t i=0; i<nbits; ++i) {
-                if (0 == (word & bitMask<Word>(i, 1)))
-                    ++result;
-            }
-        }
+        result += nSetInWord<Word>(~word & bitMask<Word>(0, nbits));
         return false;
     }
 };
@@ -682,14 +754,10 @@ struct LeastSignificantDifference {
     Optional<size_t> result;
     LeastSignificantDifference(): offset(0) {}
     bool operator()(const Word &w1, const Word &w2, size_t nbits) {
-        Word mask = bitMask<Word>(0, nbits);
-        if ((w1 & mask) != (w2 & mask)) {
-            for (size_t i=0; i<nbits; ++i) {
-                if ((w1 ^ w2) & bitMask<Word>(i, 1)) {
-                    result = offset + i;
-                    return true;
-                }
-            }
+        Word diff = (w1 ^ w2) & bitMask<Word>(0, nbits);
+        if (diff != 0) {
+            result = offset + leastSignificantSetBitInWord(diff);
+            return true;
         }
         offset += nbits;
         return false;
@@ -717,14 +785,10 @@ struct MostSignificantDifference {
     bool operator()(const Word &w1, const Word &w2, size_t nbits) {
         ASSERT_require(nbits <= offset);
         offset -= nbits;
-        Word mask = bitMask<Word>(0, nbits);
-        if ((w1 & mask) != (w2 & mask)) {
-            for (size_t i=nbits; i>0; --i) {
-                if ((w1 ^ w2) & bitMask<Word>(i-1, 1)) {
-                    result = offset + i-1;
-                    return true;
-                }
-            }
+        Word diff = (w1 ^ w2) & bitMask<Word>(0, nbits);
+        if (diff != 0) {
+            result = offset + mostSignificantSetBitInWord(diff);
+            return true;
         }
         return false;
     }
@@ -864,12 +928,39 @@ void invert(Word *words, const BitRange &range) {
     traverse(visitor, words, range, LowToHigh());
 }
 
+// Applies a bit-wise operation to two ranges.  When the ranges have the same alignment, the whole words between the first and
+// last word are processed by the operation's simple loop, which compilers turn into vector instructions.
+template<class Operation, class Word>
+void traverseBitwise(Operation &operation, const Word *vec1, const BitRange &range1, Word *vec2, const BitRange &range2) {
+    if (range1.isEmpty() || !isAlignedInPlace(vec1, range1, vec2, range2)) {
+        traverse(operation, vec1, range1, vec2, range2, LowToHigh());
+        return;
+    }
+    const Word *w1 = vec1 + wordIndex<Word>(range1.least());
+    Word *w2 = vec2 + wordIndex<Word>(range2.least());
+    size_t offsetInWord = bitIndex<Word>(range2.least());
+    size_t nRemaining = range2.size();
+    if (offsetInWord != 0 || nRemaining < bitsPerWord<Word>::value) {
+        size_t nbits = std::min(bitsPerWord<Word>::value - offsetInWord, nRemaining);
+        processWord(operation, *w1++, *w2++, offsetInWord, nbits);
+        nRemaining -= nbits;
+    }
+    size_t nWholeWords = nRemaining / bitsPerWord<Word>::value;
+    operation.wholeWords(w1, w2, nWholeWords);
+    if (size_t nbits = nRemaining % bitsPerWord<Word>::value)
+        processWord(operation, w1[nWholeWords], w2[nWholeWords], 0, nbits);
+}
+
 template<class Word>
 struct AndBits {
     bool operator()(const Word &w1, Word &w2, size_t nbits) {
         w2 &= w1 | ~bitMask<Word>(0, nbits);
         return false;
     }
+    void wholeWords(const Word *w1, Word *w2, size_t n) {
+        for (size_t i=0; i<n; ++i)
+            w2[i] &= w1[i];
+    }
 };
 
 /** Bit-wise AND.
@@ -879,7 +970,7 @@ struct AndBits {
 template<class Word>
 void bitwiseAnd(const Word *vec1, const BitRange &range1, Word *vec2, const BitRange &range2) {
     AndBits<Word> visitor;
-    traverse(visitor, vec1, range1, vec2, range2, LowToHigh());
+    traverseBitwise(visitor, vec1, range1, vec2, range2);
 }
 
 template<class Word>
@@ -888,6 +979,10 @@ struct OrBits {
         w2 |= w1 & bitMask<Word>(0, nbits);
         return false;
     }
+    void wholeWords(const Word *w1, Word *w2, size_t n) {
+        for (size_t i=0; i<n; ++i)
+            w2[i] |= w1[i];
+    }
 };
 
 /** Bit-wise OR.
@@ -897,7 +992,7 @@ struct OrBits {
 template<class Word>
 void bitwiseOr(const Word *vec1, const BitRange &range1, Word *vec2, const BitRange &range2) {
     OrBits<Word> visitor;
-    traverse(visitor, vec1, range1, vec2, range2, LowToHigh());
+    traverseBitwise(visitor, vec1, range1, vec2, range2);
 }
 
 template<class Word>
@@ -906,6 +1001,10 @@ struct XorBits {
         w2 ^= w1 & bitMask<Word>(0, nbits);
         return false;
     }
+    void wholeWords(const Word *w1, Word *w2, size_t n) {
+        for (size_t i=0; i<n; ++i)
+            w2[i] ^= w1[i];
+    }
 };
 
 /** Bit-wise XOR.
@@ -915,7 +1014,7 @@ struct XorBits {
 template<class Word>
 void bitwiseXor(const Word *vec1, const BitRange &range1, Word *vec2, const BitRange &range2) {
     XorBits<Word> visitor;
-    traverse(visitor, vec1, range1, vec2, range2, LowToHigh());
+    traverseBitwise(visitor, vec1, range1, vec2, range2);
 }
 
 
@@ -932,17 +1031,19 @@ void fromInteger(Word *words, const BitRange &range, boost::uint64_t value) {
     if (range.isEmpty())
         return;
 
-    // Create a bit vector that is just the value
+    // Store the value directly into the words it occupies, then zero-fill
     size_t nbits = std::min(range.size(), (size_t)64);  // number of significant bits to copy, not fill
-    Word wordMask = bitMask<Word>(0, bitsPerWord<Word>::value);
-    size_t nTmpWords = numberOfWords<Word>(nbits);
-    SAWYER_VARIABLE_LENGTH_ARRAY(Word, tmp, nTmpWords);
-    for (size_t i=0; i<nTmpWords; ++i)
-        tmp[i] = (value >> (i * bitsPerWord<Word>::value)) & wordMask;
-
-    // Copy the value's bit vector to the destination and zero-fill
-    copy(tmp, BitRange::baseSize(0, nbits), words, BitRange::baseSize(range.least(), nbits));
-    if (range.size() >= 64) {
+    size_t wordIdx = wordIndex<Word>(range.least());
+    size_t offsetInWord = bitIndex<Word>(range.least());
+    for (size_t nDone=0; nDone < nbits; ++wordIdx) {
+        size_t n = std::min(bitsPerWord<Word>::value - offsetInWord, nbits - nDone);
+        Word mask = bitMask<Word>(offsetInWord, n);
+        words[wordIdx] &= ~mask;
+        words[wordIdx] |= (Word)(value >> nDone) << offsetInWord & mask;
+        nDone += n;
+        offsetInWord = 0;
+    }
+    if (range.size() > 64) {
         BitRange hi = BitRange::baseSize(range.least() + 64, range.size() - 64);
         clear(words, hi);
     }
@@ -956,18 +1057,22 @@ template<class Word>
 boost::uint64_t toInteger(const Word *words, const BitRange &range) {
     boost::uint64_t result = 0;
     ASSERT_require(8==sizeof result);
+    if (range.isEmpty())
+        return 0;
 
-    // Copy the bits into the low bits of a temporary bit vector
+    // Gather the words that hold the low 64 bits of the range directly into the result
     size_t nbits = std::min(range.size(), (size_t)64);
-    size_t nTmpWords = numberOfWords<Word>(nbits);
-    SAWYER_VARIABLE_LENGTH_ARRAY(typename RemoveConst<Word>::Base, tmp, nTmpWords);
-    memset(tmp, 0, nTmpWords*sizeof(*tmp));
-    BitRange lo = BitRange::baseSize(range.least(), nbits);
-    copy(words, lo, tmp, BitRange::baseSize(0, nbits));
-
-    // Convert the temporary bit vector to an integer
-    for (size_t i=0; i<nTmpWords; ++i)
-        result |= (boost::uint64_t)tmp[i] << (i * bitsPerWord<Word>::value);
+    size_t firstWordIdx = wordIndex<Word>(range.least());
+    size_t lastWordIdx = wordIndex<Word>(range.least() + nbits - 1);
+    size_t offsetInWord = bitIndex<Word>(range.least());
+    result = (boost::uint64_t)words[firstWordIdx] >> offsetInWord;
+    size_t nHave = bitsPerWord<Word>::value - offsetInWord;
+    for (size_t i=firstWordIdx+1; i<=lastWordIdx; ++i) {
+        result |= (boost::uint64_t)words[i] << nHave;
+        nHave += bitsPerWord<Word>::value;
+    }
+    if (nbits < 64)
+        result &= ~((~UINT64_C(0)) << nbits);
     return result;
 }
 
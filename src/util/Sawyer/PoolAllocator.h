@@ -66,6 +66,10 @@ public:
     enum { N_FREE_LISTS = 32 };                          // number of free lists per pool
 
 private:
+    // Synchronization is chosen by the Sync template argument so that an unsynchronized allocator never locks.
+    typedef SynchronizationTraits<Sync> Traits;
+    typedef typename Traits::Mutex Mutex;
+    typedef typename Traits::LockGuard LockGuard;
 
     // Singly-linked list of cells (units of object backing store) that are not being used by the caller.
     struct FreeCell { FreeCell *next; };
@@ -120,10 +124,10 @@ private:
 
     // Aquire all locks for a pool.
     class LockEverything {
-        SAWYER_THREAD_TRAITS::Mutex *freeListMutexes_, &chunkMutex_;
+        Mutex *freeListMutexes_, &chunkMutex_;
         size_t nLocked_;
     public:
-        LockEverything(SAWYER_THREAD_TRAITS::Mutex *freeListMutexes, SAWYER_THREAD_TRAITS::Mutex &chunkMutex)
+        LockEverything(Mutex *freeListMutexes, Mutex &chunkMutex)
             : freeListMutexes_(freeListMutexes), chunkMutex_(chunkMutex), nLocked_(0) {
             while (nLocked_ < N_FREE_LISTS) {
                 freeListMutexes_[nLocked_].lock();
@@ -151,19 +155,27 @@ private:
         // free-list uniformly at random in order to keep the sizes of the free-lists relatively equal. There is no requirement
         // that an object allocated from one free-list be released back to the same free-list. Each free-list has its own
         // mutex. When locking multiple free-lists, the locks should be aquired in order of their indexes.
-        SAWYER_THREAD_TRAITS::Mutex freeListMutexes_[N_FREE_LISTS];
+        Mutex freeListMutexes_[N_FREE_LISTS];
         FreeCell *freeLists_[N_FREE_LISTS];
 
         // The chunk-list stores the memory allocated for objects.  The chunk-list is protected by a mutex. When locking
         // free-list(s) and the chunk-list, the free-list locks should be aquired first.
-        mutable SAWYER_THREAD_TRAITS::Mutex chunkMutex_;
+        mutable Mutex chunkMutex_;
         std::list<Chunk*> chunks_;
 
     private:
         Pool(const Pool&);                              // nonsense
 
+        // Multiple free lists only reduce contention, so an allocator without synchronization uses just the first one.
+        static size_t freeListIndex() {
+            return Traits::SUPPORTED ? fastRandomIndex(N_FREE_LISTS) : 0;
+        }
+
     public:
-        Pool(): cellSize_(0) {}
+        Pool(): cellSize_(0) {
+            for (size_t i=0; i<N_FREE_LISTS; ++i)
+                freeLists_[i] = NULL;
+        }
 
         void init(size_t cellSize) {
             assert(cellSize_ == 0);
@@ -178,18 +190,18 @@ private:
         }
 
         bool isEmpty() const {
-            SAWYER_THREAD_TRAITS::LockGuard lock(chunkMutex_);
+            LockGuard lock(chunkMutex_);
             return chunks_.empty();
         }
 
         // Obtains the cell at the front of the free list, allocating more space if necessary.
         void* aquire() {                                // hot
-            const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
-            SAWYER_THREAD_TRAITS::LockGuard lock(freeListMutexes_[freeListIdx]);
+            const size_t freeListIdx = freeListIndex();
+            LockGuard lock(freeListMutexes_[freeListIdx]);
             if (!freeLists_[freeListIdx]) {
                 Chunk *chunk = new Chunk;
                 freeLists_[freeListIdx] = chunk->fill(cellSize_);
-                SAWYER_THREAD_TRAITS::LockGuard lock(chunkMutex_);
+                LockGuard lock(chunkMutex_);
                 chunks_.push_back(chunk);
             }
             ASSERT_not_null(freeLists_[freeListIdx]);
@@ -201,8 +213,8 @@ private:
 
         // Returns an cell to the front of the free list.
         void release(void *cell) {                      // hot
-            const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
-            SAWYER_THREAD_TRAITS::LockGuard lock(freeListMutexes_[freeListIdx]);
+            const size_t freeListIdx = freeListIndex();
+            LockGuard lock(freeListMutexes_[freeListIdx]);
             ASSERT_not_null(cell);
             FreeCell *freedCell = reinterpret_cast<FreeCell*>(cell);
             freedCell->next = freeLists_[freeListIdx];
@@ -237,7 +249,7 @@ private:
                 }
             }
 
-            size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
+            size_t freeListIdx = freeListIndex();
             size_t nNeeded = nObjects - nFree;
             const size_t cellsPerChunk = chunkSize / cellSize_;
             while (1) {
@@ -307,7 +319,7 @@ private:
         size_t showInfo(std::ostream &out) const {
             ChunkInfoMap cim;
             {
-                LockEverything guard(const_cast<SAWYER_THREAD_TRAITS::Mutex*>(freeListMutexes_), chunkMutex_);
+                LockEverything guard(const_cast<Mutex*>(freeListMutexes_), chunkMutex_);
                 cim = chunkInfoNS();
             }
 
@@ -323,7 +335,7 @@ private:
         std::pair<size_t, size_t> nAllocated() const {
             ChunkInfoMap cim;
             {
-                LockEverything guard(const_cast<SAWYER_THREAD_TRAITS::Mutex*>(freeListMutexes_), chunkMutex_);
+                LockEverything guard(const_cast<Mutex*>(freeListMutexes_), chunkMutex_);
                 cim = chunkInfoNS();
             }
 
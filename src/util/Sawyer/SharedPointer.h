@@ -292,6 +292,16 @@ public:
 
 };
 
+/** Whether an object's reference count needs to be locked.
+ *
+ *  @ref SharedPointer calls this unqualified each time it changes or reads a reference count, so a class derived from @ref
+ *  SharedObject can declare an overload taking a pointer to that class in the class's own namespace. Such an overload may return
+ *  false for objects that are only ever used by one thread, whose reference counts then don't lock the mutex. This default
+ *  always locks. */
+inline bool sharedOwnershipIsSynchronized(const SharedObject*) {
+    return true;
+}
+
 /** Creates SharedPointer from this.
  *
  *  This class provides a @ref sharedFromThis method that returns a @ref SharedPointer pointing to an object of type @c T.
@@ -356,6 +366,8 @@ public:
 template<class T>
 inline size_t SharedPointer<T>::ownershipCount(T *rawPtr) {
     if (rawPtr) {
+        if (!sharedOwnershipIsSynchronized(rawPtr))
+            return rawPtr->SharedObject::nrefs_;
         SAWYER_THREAD_TRAITS::LockGuard lock(rawPtr->SharedObject::mutex_);
         return rawPtr->SharedObject::nrefs_;
     }
@@ -365,14 +377,22 @@ inline size_t SharedPointer<T>::ownershipCount(T *rawPtr) {
 template<class T>
 inline void SharedPointer<T>::acquireOwnership(Pointee *rawPtr) {
     if (rawPtr!=NULL) {
-        SAWYER_THREAD_TRAITS::LockGuard lock(rawPtr->SharedObject::mutex_);
-        ++rawPtr->SharedObject::nrefs_;
+        if (!sharedOwnershipIsSynchronized(rawPtr)) {
+            ++rawPtr->SharedObject::nrefs_;
+        } else {
+            SAWYER_THREAD_TRAITS::LockGuard lock(rawPtr->SharedObject::mutex_);
+            ++rawPtr->SharedObject::nrefs_;
+        }
     }
 }
 
 template<class T>
 inline size_t SharedPointer<T>::releaseOwnership(Pointee *rawPtr) {
     if (rawPtr!=NULL) {
+        if (!sharedOwnershipIsSynchronized(rawPtr)) {
+            assert(rawPtr->SharedObject::nrefs_ > 0);
+            return --rawPtr->SharedObject::nrefs_;
+        }
         SAWYER_THREAD_TRAITS::LockGuard lock(rawPtr->SharedObject::mutex_);
         assert(rawPtr->SharedObject::nrefs_ > 0);
         return --rawPtr->SharedObject::nrefs_;
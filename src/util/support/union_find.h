@@ -34,13 +34,19 @@ class UF_elem
          p1->size += p2->size;
        }
      } 
+   // Iterative, so that long chains cannot overflow the stack; every element on the path is then
+   // linked directly to the root (path compression).
    UF_elem * find_group()
    {
-     if (this->p_group == this->p_group->p_group)
-       return this->p_group;
-     
-     p_group = p_group->find_group();
-     return p_group;
+     UF_elem *root = p_group;
+     while (root != root->p_group)
+       root = root->p_group;
+     for (UF_elem *p = this; p != root; ) {
+       UF_elem *next = p->p_group;
+       p->p_group = root;
+       p = next;
+     }
+     return root;
    }
    unsigned group_size() const { return size; }
 };
@@ -0,0 +1,21 @@
+// Shared header comment: first
+#ifndef SHARED_H
+#define SHARED_H
+
+#define SHARED_INITIAL_VALUE 15
+
+/* Shared header comment: second */
+class Shared{
+
+  public:
+    // Shared header comment: third
+    int v1_rename_me;
+
+#ifdef SHARED_HAS_SECOND_FIELD
+    int v2;
+#endif
+
+    Shared();
+};
+
+#endif
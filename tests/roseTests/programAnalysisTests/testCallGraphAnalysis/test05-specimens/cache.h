@@ -0,0 +1,6 @@
+// Included by cache.C; the call graph cache must be invalidated when this file changes.
+int square(int x);
+
+inline int twice(int x) { return square(x) + square(x); }
+
+typedef int (*Operation)(int);